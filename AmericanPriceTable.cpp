@@ -0,0 +1,278 @@
+#include "AmericanPriceTable.h"
+#include "BinomialEngine.h"
+#include "BlackScholesEngine.h"
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char TABLE_MAGIC[8] = {'A', 'M', 'C', 'H', 'E', 'B', '1', '\0'};
+const uint32_t TABLE_VERSION = 2;
+
+// American minus European tree price at strike 1 and maturity 1, where the
+// normalized coordinates map directly onto the option's parameters
+double treePremium(OptionType type, const double* coordinates, int steps) {
+    double volatility = coordinates[1];
+    double spot = std::exp(coordinates[0] * volatility);
+    double rate = coordinates[2];
+    double dividendYield = coordinates[3];
+    
+    BinomialEngine tree;
+    PricingConfig config;
+    config.binomialSteps = steps;
+    Option american(spot, 1.0, rate, volatility, 1.0, type, ExerciseType::AMERICAN, dividendYield);
+    Option european(spot, 1.0, rate, volatility, 1.0, type, ExerciseType::EUROPEAN, dividendYield);
+    return tree.price(american, config) - tree.price(european, config);
+}
+
+}
+
+AmericanPriceTable::AmericanPriceTable(std::shared_ptr<const char> storage, size_t size)
+    : storage_(storage) {
+    if (size < sizeof(Header)) {
+        throw std::invalid_argument("American price table is truncated");
+    }
+    header_ = reinterpret_cast<const Header*>(storage_.get());
+    if (std::memcmp(header_->magic, TABLE_MAGIC, sizeof(TABLE_MAGIC)) != 0 || header_->version != TABLE_VERSION) {
+        throw std::invalid_argument("Not an American price table");
+    }
+    
+    coefficientCount_ = 1;
+    for (int d = 0; d < DIMENSIONS; ++d) {
+        if (header_->nodes[d] < 2 || header_->nodes[d] > MAX_NODES) {
+            throw std::invalid_argument("American price table has an invalid node count");
+        }
+        coefficientCount_ *= header_->nodes[d];
+    }
+    if (size != sizeof(Header) + coefficientCount_ * sizeof(double)) {
+        throw std::invalid_argument("American price table size does not match its header");
+    }
+    coefficients_ = reinterpret_cast<const double*>(storage_.get() + sizeof(Header));
+}
+
+AmericanPriceTable AmericanPriceTable::build(OptionType type) {
+    return build(type, BuildSettings());
+}
+
+AmericanPriceTable AmericanPriceTable::build(OptionType type, const BuildSettings& settings, ThreadPool& pool) {
+    size_t count = 1;
+    for (int d = 0; d < DIMENSIONS; ++d) {
+        if (settings.nodes[d] < 2 || settings.nodes[d] > MAX_NODES || !(settings.lower[d] < settings.upper[d])) {
+            throw std::invalid_argument("Each table coordinate needs 2 to 64 nodes and a non-empty range");
+        }
+        count *= settings.nodes[d];
+    }
+    if (settings.lower[1] <= 0.0 || settings.treeSteps < 1 || settings.validationTreeSteps < 1) {
+        throw std::invalid_argument("Table total variance must be positive and tree steps at least 1");
+    }
+    
+    size_t size = sizeof(Header) + count * sizeof(double);
+    std::shared_ptr<char> buffer(new char[size], std::default_delete<char[]>());
+    Header* header = reinterpret_cast<Header*>(buffer.get());
+    std::memset(header, 0, sizeof(Header));
+    std::memcpy(header->magic, TABLE_MAGIC, sizeof(TABLE_MAGIC));
+    header->version = TABLE_VERSION;
+    header->optionType = static_cast<uint32_t>(type);
+    header->treeSteps = settings.treeSteps;
+    header->validationTreeSteps = settings.validationTreeSteps;
+    for (int d = 0; d < DIMENSIONS; ++d) {
+        header->nodes[d] = settings.nodes[d];
+        header->lower[d] = settings.lower[d];
+        header->upper[d] = settings.upper[d];
+    }
+    double* coefficients = reinterpret_cast<double*>(buffer.get() + sizeof(Header));
+    
+    // Premiums at the tensor grid of Chebyshev points, one tree pair per node
+    std::vector<size_t> strides(DIMENSIONS, 1);
+    for (int d = DIMENSIONS - 2; d >= 0; --d) {
+        strides[d] = strides[d + 1] * settings.nodes[d + 1];
+    }
+    pool.parallelFor(count, 16, [&](size_t first, size_t last) {
+        for (size_t index = first; index < last; ++index) {
+            double coordinates[DIMENSIONS];
+            for (int d = 0; d < DIMENSIONS; ++d) {
+                int j = static_cast<int>((index / strides[d]) % settings.nodes[d]);
+                double t = std::cos(M_PI * (j + 0.5) / settings.nodes[d]);
+                coordinates[d] = 0.5 * (settings.lower[d] + settings.upper[d]) +
+                                 0.5 * (settings.upper[d] - settings.lower[d]) * t;
+            }
+            coefficients[index] = treePremium(type, coordinates, settings.treeSteps);
+        }
+    });
+    
+    // Discrete cosine transform along each coordinate turns node values into coefficients
+    std::vector<double> fiber;
+    for (int d = 0; d < DIMENSIONS; ++d) {
+        int n = settings.nodes[d];
+        fiber.resize(n);
+        for (size_t base = 0; base < count; ++base) {
+            if ((base / strides[d]) % n != 0) {
+                continue;
+            }
+            for (int j = 0; j < n; ++j) {
+                fiber[j] = coefficients[base + j * strides[d]];
+            }
+            for (int k = 0; k < n; ++k) {
+                double sum = 0.0;
+                for (int j = 0; j < n; ++j) {
+                    sum += fiber[j] * std::cos(M_PI * k * (j + 0.5) / n);
+                }
+                coefficients[base + k * strides[d]] = (k == 0 ? 1.0 : 2.0) * sum / n;
+            }
+        }
+    }
+    
+    AmericanPriceTable table(buffer, size);
+    
+    // Off-node validation against a finer tree than the nodes were built from
+    std::vector<double> points(settings.validationPoints * DIMENSIONS);
+    std::mt19937_64 generator(42);
+    for (int p = 0; p < settings.validationPoints; ++p) {
+        for (int d = 0; d < DIMENSIONS; ++d) {
+            std::uniform_real_distribution<double> uniform(settings.lower[d], settings.upper[d]);
+            points[p * DIMENSIONS + d] = uniform(generator);
+        }
+    }
+    std::vector<double> errors(settings.validationPoints);
+    pool.parallelFor(errors.size(), 4, [&](size_t first, size_t last) {
+        for (size_t p = first; p < last; ++p) {
+            const double* coordinates = &points[p * DIMENSIONS];
+            double reference = treePremium(type, coordinates, settings.validationTreeSteps);
+            errors[p] = std::fabs(table.premium(coordinates) - reference);
+        }
+    });
+    double validationError = 0.0;
+    for (size_t p = 0; p < errors.size(); ++p) {
+        validationError = std::max(validationError, errors[p]);
+    }
+    header->validationError = validationError;
+    
+    return table;
+}
+
+void AmericanPriceTable::save(const std::string& path) const {
+    std::ofstream file(path.c_str(), std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(header_), sizeof(Header));
+    file.write(reinterpret_cast<const char*>(coefficients_), coefficientCount_ * sizeof(double));
+    if (!file) {
+        throw std::runtime_error("Failed to write American price table to " + path);
+    }
+}
+
+AmericanPriceTable AmericanPriceTable::load(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open American price table " + path);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot read American price table " + path);
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        throw std::runtime_error("Cannot map American price table " + path);
+    }
+    
+    std::shared_ptr<const char> storage(static_cast<const char*>(mapped),
+                                        [size](const char* data) { ::munmap(const_cast<char*>(data), size); });
+    return AmericanPriceTable(storage, size);
+}
+
+OptionType AmericanPriceTable::getOptionType() const {
+    return static_cast<OptionType>(header_->optionType);
+}
+
+double AmericanPriceTable::getValidationError() const {
+    return header_->validationError;
+}
+
+int AmericanPriceTable::getValidationTreeSteps() const {
+    return static_cast<int>(header_->validationTreeSteps);
+}
+
+void AmericanPriceTable::normalize(const Option& option, double coordinates[DIMENSIONS]) {
+    double T = option.getTimeToMaturity();
+    double sigma = option.getVolatility();
+    coordinates[1] = sigma * std::sqrt(T);
+    coordinates[0] = std::log(option.getSpot() / option.getStrike()) / coordinates[1];
+    coordinates[2] = option.getRate() * T;
+    coordinates[3] = option.getDividendYield() * T;
+}
+
+bool AmericanPriceTable::contains(const Option& option) const {
+    if (option.getOptionType() != getOptionType() || option.getTimeToMaturity() <= 0.0) {
+        return false;
+    }
+    double coordinates[DIMENSIONS];
+    normalize(option, coordinates);
+    for (int d = 0; d < DIMENSIONS; ++d) {
+        if (!(coordinates[d] >= header_->lower[d] && coordinates[d] <= header_->upper[d])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+double AmericanPriceTable::price(const Option& option) const {
+    if (!contains(option)) {
+        throw std::out_of_range("Option is outside the American price table's domain");
+    }
+    double coordinates[DIMENSIONS];
+    normalize(option, coordinates);
+    
+    Option european(option.getSpot(), option.getStrike(), option.getRate(), option.getVolatility(),
+                    option.getTimeToMaturity(), option.getOptionType(), ExerciseType::EUROPEAN,
+                    option.getDividendYield());
+    // The interpolant is only C1 across the exercise boundary; flooring at
+    // intrinsic removes its undershoot where immediate exercise is optimal
+    double value = BlackScholesEngine().price(european) + option.getStrike() * premium(coordinates);
+    return std::max(value, option.payoff(option.getSpot()));
+}
+
+double AmericanPriceTable::premium(const double coordinates[DIMENSIONS]) const {
+    // Chebyshev polynomials of each coordinate, then contraction from the last
+    // coordinate inwards: one multiply-add per coefficient
+    double polynomials[DIMENSIONS][MAX_NODES];
+    for (int d = 0; d < DIMENSIONS; ++d) {
+        int n = header_->nodes[d];
+        double t = (2.0 * coordinates[d] - header_->lower[d] - header_->upper[d]) /
+                   (header_->upper[d] - header_->lower[d]);
+        polynomials[d][0] = 1.0;
+        polynomials[d][1] = t;
+        for (int k = 2; k < n; ++k) {
+            polynomials[d][k] = 2.0 * t * polynomials[d][k - 1] - polynomials[d][k - 2];
+        }
+    }
+    
+    const int n0 = header_->nodes[0], n1 = header_->nodes[1], n2 = header_->nodes[2], n3 = header_->nodes[3];
+    const double* c = coefficients_;
+    double total = 0.0;
+    for (int i0 = 0; i0 < n0; ++i0) {
+        double sum1 = 0.0;
+        for (int i1 = 0; i1 < n1; ++i1) {
+            double sum2 = 0.0;
+            for (int i2 = 0; i2 < n2; ++i2) {
+                double sum3 = 0.0;
+                for (int i3 = 0; i3 < n3; ++i3) {
+                    sum3 += c[i3] * polynomials[3][i3];
+                }
+                c += n3;
+                sum2 += sum3 * polynomials[2][i2];
+            }
+            sum1 += sum2 * polynomials[1][i1];
+        }
+        total += sum1 * polynomials[0][i0];
+    }
+    return total;
+}
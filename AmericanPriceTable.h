@@ -0,0 +1,83 @@
+// AmericanPriceTable.h
+#ifndef AMERICAN_PRICE_TABLE_H
+#define AMERICAN_PRICE_TABLE_H
+
+#include "Option.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Tensor-product Chebyshev interpolant of the American early-exercise premium
+// per unit strike, in the normalized coordinates
+//   ln(S / K) / (sigma sqrt(T)),  sigma sqrt(T),  r T,  q T
+// which determine an American price up to the strike scale. Scaling moneyness by
+// the total volatility keeps the exercise boundary at a similar coordinate across
+// vols. Online prices are the Black-Scholes European price plus the interpolated
+// premium, floored at intrinsic value.
+//
+// Tables are built offline from paired American/European binomial trees, which
+// cancels most of the tree's discretization error, and are stored in a flat
+// file that load() maps into memory without parsing.
+class AmericanPriceTable {
+public:
+    static const int DIMENSIONS = 4;
+    static const int MAX_NODES = 64;
+    
+    struct BuildSettings {
+        int nodes[DIMENSIONS] = {16, 12, 8, 8};  // Chebyshev points per coordinate
+        double lower[DIMENSIONS] = {-3.0, 0.05, 0.0, 0.0};
+        double upper[DIMENSIONS] = {3.0, 0.6, 0.10, 0.10};
+        int treeSteps = 1000;
+        int validationPoints = 256;
+        int validationTreeSteps = 2000;  // finer than treeSteps, so node error shows too
+    };
+    
+    static AmericanPriceTable build(OptionType type);
+    static AmericanPriceTable build(OptionType type, const BuildSettings& settings,
+                                    ThreadPool& pool = ThreadPool::shared());
+    
+    void save(const std::string& path) const;
+    static AmericanPriceTable load(const std::string& path);
+    
+    OptionType getOptionType() const;
+    bool contains(const Option& option) const;
+    
+    // Throws std::out_of_range outside the table's domain
+    double price(const Option& option) const;
+    
+    // Largest premium error per unit strike measured at the random off-node
+    // validation points against a tree pair of getValidationTreeSteps() steps.
+    // It covers interpolation and build-tree error but is a measured maximum,
+    // not a guaranteed bound, and excludes the validation tree's own error.
+    double getValidationError() const;
+    int getValidationTreeSteps() const;
+    
+    size_t getCoefficientCount() const { return coefficientCount_; }
+
+private:
+    // On-disk layout: Header followed directly by the coefficients, last coordinate fastest
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t optionType;
+        uint32_t nodes[DIMENSIONS];
+        uint32_t treeSteps;
+        uint32_t validationTreeSteps;
+        double lower[DIMENSIONS];
+        double upper[DIMENSIONS];
+        double validationError;
+    };
+    
+    std::shared_ptr<const char> storage_;  // owned buffer or mapped file
+    const Header* header_;
+    const double* coefficients_;
+    size_t coefficientCount_;
+    
+    AmericanPriceTable(std::shared_ptr<const char> storage, size_t size);
+    
+    static void normalize(const Option& option, double coordinates[DIMENSIONS]);
+    double premium(const double coordinates[DIMENSIONS]) const;
+};
+
+#endif
@@ -1,48 +1,161 @@
 #include "BinomialEngine.h"
+#include "AmericanPriceTable.h"
+#include "Payoff.h"
 #include <cmath>
 #include <algorithm>
+#include <stdexcept>
 
-double BinomialEngine::price(const Option& option) {
-    TreeParameters params = calculateTreeParameters(option);
+double BinomialEngine::price(const Option& quoted, const PricingConfig& config) const {
+    const Option option = resolveMarketData(quoted, config);
+    bool american = option.getExerciseType() == ExerciseType::AMERICAN;
+    if (american && config.useAmericanPriceTables) {
+        const AmericanPriceTable* table = (option.getOptionType() == OptionType::CALL) ? callTable_.get()
+                                                                                      : putTable_.get();
+        if (table && table->contains(option)) {
+            return table->price(option);
+        }
+    }
+    
+    const int steps = config.binomialSteps;
+    TreeParameters params = calculateTreeParameters(option, steps);
+    return rollback(option, params, steps, 0)[0];
+}
+
+void BinomialEngine::priceSpots(const Option& quoted, const double* spots, size_t count, double* out,
+                                const PricingConfig& config) const {
+    const Option option = resolveMarketData(quoted, config);
+    const double spotShift = option.getSpot() - quoted.getSpot();  // escrowed cash dividends
+    const AmericanPriceTable* table = nullptr;
+    if (option.getExerciseType() == ExerciseType::AMERICAN && config.useAmericanPriceTables) {
+        table = (option.getOptionType() == OptionType::CALL) ? callTable_.get() : putTable_.get();
+    }
+    
+    // Table prices where possible; the rest share one lattice over their spot range
+    std::vector<size_t> latticeSpots;
+    double lowest = 0.0, highest = 0.0;
+    for (size_t k = 0; k < count; ++k) {
+        double spot = spots[k] + spotShift;
+        if (spot <= 0.0) {
+            throw std::invalid_argument("Spot grid must stay positive after escrowed dividends");
+        }
+        Option atSpot(spot, option.getStrike(), option.getRate(), option.getVolatility(),
+                      option.getTimeToMaturity(), option.getOptionType(), option.getExerciseType(),
+                      option.getDividendYield());
+        if (table && table->contains(atSpot)) {
+            out[k] = table->price(atSpot);
+            continue;
+        }
+        lowest = latticeSpots.empty() ? spot : std::min(lowest, spot);
+        highest = latticeSpots.empty() ? spot : std::max(highest, spot);
+        latticeSpots.push_back(k);
+    }
+    if (latticeSpots.empty()) {
+        return;
+    }
+    
+    // Centre the lattice on the spot range and add steps before the valuation date
+    // until the nodes there reach a node beyond either end of it
+    const int steps = config.binomialSteps;
+    const double dt = option.getTimeToMaturity() / steps;
+    const double logU = option.getVolatility() * std::sqrt(dt);
+    const double centre = std::sqrt(lowest * highest);
+    const int extraSteps = std::max(static_cast<int>(std::ceil(std::log(highest / centre) / logU)) + 1, 2);
+    
+    Option extended(centre, option.getStrike(), option.getRate(), option.getVolatility(),
+                    dt * (steps + extraSteps), option.getOptionType(), option.getExerciseType(),
+                    option.getDividendYield());
+    TreeParameters params = calculateTreeParameters(extended, steps + extraSteps);
+    const double* values = rollback(extended, params, steps + extraSteps, extraSteps);
     
-    // Initialize option values at maturity
-    std::vector<double> optionValues(steps_ + 1);
+    // Node i at the valuation date sits at centre * u^(2i - extraSteps)
+    for (size_t j = 0; j < latticeSpots.size(); ++j) {
+        size_t k = latticeSpots[j];
+        double position = 0.5 * (std::log((spots[k] + spotShift) / centre) / logU + extraSteps);
+        int i = std::min(std::max(static_cast<int>(std::lround(position)), 1), extraSteps - 1);
+        
+        double x0 = centre * std::exp(logU * (2 * i - 2 - extraSteps));
+        double x1 = centre * std::exp(logU * (2 * i - extraSteps));
+        double x2 = centre * std::exp(logU * (2 * i + 2 - extraSteps));
+        double x = spots[k] + spotShift;
+        out[k] = values[i - 1] * (x - x1) * (x - x2) / ((x0 - x1) * (x0 - x2)) +
+                 values[i] * (x - x0) * (x - x2) / ((x1 - x0) * (x1 - x2)) +
+                 values[i + 1] * (x - x0) * (x - x1) / ((x2 - x0) * (x2 - x1));
+    }
+}
+
+const double* BinomialEngine::rollback(const Option& option, const TreeParameters& params, int steps,
+                                       int firstStep) const {
+    bool american = option.getExerciseType() == ExerciseType::AMERICAN;
+    if (option.getOptionType() == OptionType::CALL) {
+        return american ? backwardInduction<OptionType::CALL, ExerciseType::AMERICAN>(option, params, steps, firstStep)
+                        : backwardInduction<OptionType::CALL, ExerciseType::EUROPEAN>(option, params, steps, firstStep);
+    }
+    return american ? backwardInduction<OptionType::PUT, ExerciseType::AMERICAN>(option, params, steps, firstStep)
+                    : backwardInduction<OptionType::PUT, ExerciseType::EUROPEAN>(option, params, steps, firstStep);
+}
+
+template <OptionType Type, ExerciseType Exercise>
+const double* BinomialEngine::backwardInduction(const Option& option, const TreeParameters& params, int steps,
+                                                int firstStep) const {
+    const VanillaPayoff<Type> payoff(option.getStrike());
+    
+    // Per-thread scratch buffers: after warm-up the tree allocates nothing
+    thread_local std::vector<double> optionValues;
+    thread_local std::vector<double> nodeSpots;
+    optionValues.resize(steps + 1);
+    
+    // With d = 1/u the spot at (step, i) is S * u^(2i - step), so every node's
+    // spot is a lookup into one table of 2 * steps + 1 powers
+    nodeSpots.resize(2 * steps + 1);
+    for (int m = 0; m <= 2 * steps; ++m) {
+        nodeSpots[m] = option.getSpot() * std::pow(params.u, m - steps);
+    }
     
     // Calculate option values at expiration
-    for (int i = 0; i <= steps_; ++i) {
-        double spotAtExpiry = option.getSpot() * std::pow(params.u, i) * std::pow(params.d, steps_ - i);
-        optionValues[i] = option.payoff(spotAtExpiry);
+    for (int i = 0; i <= steps; ++i) {
+        optionValues[i] = payoff(nodeSpots[2 * i]);
     }
     
-    // Backward induction
-    for (int step = steps_ - 1; step >= 0; --step) {
+    // Backward induction with the discounted probabilities hoisted out of the loop
+    double discount = std::exp(-option.getRate() * params.dt);
+    double upWeight = discount * params.p;
+    double downWeight = discount * (1 - params.p);
+    double* values = optionValues.data();
+    const double* spots = nodeSpots.data();
+    
+    for (int step = steps - 1; step >= firstStep; --step) {
+        const double* stepSpots = spots + steps - step;
         for (int i = 0; i <= step; ++i) {
-            // Calculate continuation value
-            double continuationValue = std::exp(-option.getRate() * params.dt) * 
-                                     (params.p * optionValues[i + 1] + (1 - params.p) * optionValues[i]);
-            
-            if (option.getExerciseType() == ExerciseType::AMERICAN) {
-                // Calculate intrinsic value for early exercise
-                double spotPrice = option.getSpot() * std::pow(params.u, i) * std::pow(params.d, step - i);
-                double intrinsicValue = option.payoff(spotPrice);
-                optionValues[i] = std::max(continuationValue, intrinsicValue);
+            double continuationValue = upWeight * values[i + 1] + downWeight * values[i];
+            if (Exercise == ExerciseType::AMERICAN) {
+                values[i] = std::max(continuationValue, payoff(stepSpots[2 * i]));
             } else {
-                optionValues[i] = continuationValue;
+                values[i] = continuationValue;
             }
         }
     }
     
-    return optionValues[0];
+    return values;
+}
+
+void BinomialEngine::setAmericanPriceTables(std::shared_ptr<const AmericanPriceTable> calls,
+                                            std::shared_ptr<const AmericanPriceTable> puts) {
+    if ((calls && calls->getOptionType() != OptionType::CALL) || (puts && puts->getOptionType() != OptionType::PUT)) {
+        throw std::invalid_argument("American price tables must match their option types");
+    }
+    callTable_ = calls;
+    putTable_ = puts;
 }
 
-BinomialEngine::TreeParameters BinomialEngine::calculateTreeParameters(const Option& option) {
+BinomialEngine::TreeParameters BinomialEngine::calculateTreeParameters(const Option& option, int steps) const {
     TreeParameters params;
-    params.dt = option.getTimeToMaturity() / steps_;
+    params.dt = option.getTimeToMaturity() / steps;
     
     // Cox-Ross-Rubinstein parameterization
     params.u = std::exp(option.getVolatility() * std::sqrt(params.dt));
     params.d = 1.0 / params.u;
-    params.p = (std::exp(option.getRate() * params.dt) - params.d) / (params.u - params.d);
+    params.p = (std::exp((option.getRate() - option.getDividendYield()) * params.dt) - params.d) /
+               (params.u - params.d);
     
     return params;
 }
@@ -3,26 +3,52 @@
 #define BINOMIAL_ENGINE_H
 
 #include "PricingEngine.h"
+#include <memory>
 #include <vector>
 
+class AmericanPriceTable;
+
 class BinomialEngine : public PricingEngine {
 public:
-    BinomialEngine(int steps = 100) : steps_(steps) {}
-    
-    double price(const Option& option) override;
+    using PricingEngine::price;
+    double price(const Option& option, const PricingConfig& config) const override;
     std::string getMethodName() const override { return "Binomial Tree"; }
     
-    void setSteps(int steps) { steps_ = steps; }
+    // Prices the option at each of count spots from a single lattice: the tree is
+    // extended backwards past the valuation date until its nodes there span the
+    // spots, which are then interpolated quadratically between neighbouring nodes.
+    // Market data is resolved once at the option's own spot. With
+    // useAmericanPriceTables, American options inside a table's domain are still
+    // priced from the table.
+    void priceSpots(const Option& option, const double* spots, size_t count, double* out,
+                    const PricingConfig& config) const;
+    
+    // With PricingConfig::useAmericanPriceTables, American options inside a
+    // table's domain are priced from it; the tree is used for everything else.
+    // Set before the engine is shared between threads.
+    void setAmericanPriceTables(std::shared_ptr<const AmericanPriceTable> calls,
+                                std::shared_ptr<const AmericanPriceTable> puts);
 
 private:
-    int steps_;
+    std::shared_ptr<const AmericanPriceTable> callTable_;
+    std::shared_ptr<const AmericanPriceTable> putTable_;
     
     struct TreeParameters {
         double u, d, p;
         double dt;
     };
     
-    TreeParameters calculateTreeParameters(const Option& option);
+    TreeParameters calculateTreeParameters(const Option& option, int steps) const;
+    
+    // Option and exercise type are resolved once per price call, leaving the
+    // O(N^2) backward induction free of branches. Rolls back from the option's
+    // expiry to firstStep and returns the firstStep + 1 node values there, lowest
+    // spot first, in a per-thread buffer.
+    template <OptionType Type, ExerciseType Exercise>
+    const double* backwardInduction(const Option& option, const TreeParameters& params, int steps,
+                                    int firstStep = 0) const;
+    
+    const double* rollback(const Option& option, const TreeParameters& params, int steps, int firstStep) const;
 };
 
 #endif
@@ -1,42 +1,361 @@
 #include "BlackScholesEngine.h"
+#include "OptionChain.h"
+#include "VolatilitySurface.h"
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
+#include <limits>
 
-double BlackScholesEngine::price(const Option& option) {
+double BlackScholesEngine::price(const Option& quoted, const PricingConfig& config) const {
+    const Option option = resolveMarketData(quoted, config);
     if (option.getExerciseType() == ExerciseType::AMERICAN) {
         throw std::invalid_argument("Black-Scholes only supports European options");
     }
     
+    if (option.getOptionType() == OptionType::CALL) {
+        return priceKernel<OptionType::CALL>(option);
+    }
+    return priceKernel<OptionType::PUT>(option);
+}
+
+template <OptionType Type>
+double BlackScholesEngine::priceKernel(const Option& option) const {
     // C++14 compatible - no structured binding
     std::pair<double, double> d_values = calculateD1D2(option);
     double d1 = d_values.first;
     double d2 = d_values.second;
+    double discountedStrike = option.getStrike() * std::exp(-option.getRate() * option.getTimeToMaturity());
+    double discountedSpot = option.getSpot() * dividendDiscount(option);
     
-    if (option.getOptionType() == OptionType::CALL) {
-        return option.getSpot() * cumulativeNormalDistribution(d1) - 
-               option.getStrike() * std::exp(-option.getRate() * option.getTimeToMaturity()) * 
-               cumulativeNormalDistribution(d2);
-    } else {
-        return option.getStrike() * std::exp(-option.getRate() * option.getTimeToMaturity()) * 
-               cumulativeNormalDistribution(-d2) - 
-               option.getSpot() * cumulativeNormalDistribution(-d1);
+    if (Type == OptionType::CALL) {
+        return discountedSpot * cumulativeNormalDistribution(d1) - 
+               discountedStrike * cumulativeNormalDistribution(d2);
+    }
+    return discountedStrike * cumulativeNormalDistribution(-d2) - 
+           discountedSpot * cumulativeNormalDistribution(-d1);
+}
+
+void BlackScholesEngine::priceChain(const OptionChain& chain, const PricingConfig& config,
+                                    std::vector<double>& out) const {
+    if (!chain.isFinalized()) {
+        throw std::logic_error("OptionChain must be finalized before pricing");
+    }
+    
+    out.resize(chain.size());
+    const double* strikes = chain.strikes();
+    const double* vols = chain.volatilities();
+    const OptionType* types = chain.types();
+    const ExerciseType* exercises = chain.exercises();
+    const std::vector<OptionChain::ExpiryGroup>& groups = chain.getExpiryGroups();
+    
+    const VolatilitySurface* surface = config.volatilitySurface.get();
+    
+    for (auto group = groups.begin(); group != groups.end(); ++group) {
+        // Prepaid forward: spot net of cash dividends, discounted at the dividend yield
+        double S = group->forward * group->discountFactor;
+        double logS = std::log(S);
+        double rT = group->rate * group->timeToMaturity;
+        
+        // With a surface, one time interpolation per group; each leg is then an O(1) smile lookup
+        VolatilitySurface::Slice slice;
+        if (surface) {
+            slice = surface->sliceAt(group->timeToMaturity);
+        }
+        double logForward = logS + rT;
+        
+        for (size_t leg = group->begin; leg < group->end; ++leg) {
+            double sigma = surface ? slice.volatility(std::log(strikes[leg]) - logForward) : vols[leg];
+            double sigmaSqrtT = sigma * group->sqrtT;
+            double discountedStrike = strikes[leg] * group->discountFactor;
+            double d1 = (logS - std::log(strikes[leg]) + rT) / sigmaSqrtT + 0.5 * sigmaSqrtT;
+            double d2 = d1 - sigmaSqrtT;
+            
+            // phi = +1 for calls, -1 for puts: phi * (S N(phi d1) - K e^{-rT} N(phi d2))
+            // with S the prepaid forward
+            double phi = (types[leg] == OptionType::CALL) ? 1.0 : -1.0;
+            double value = phi * (S * cumulativeNormalDistribution(phi * d1) -
+                                  discountedStrike * cumulativeNormalDistribution(phi * d2));
+            out[leg] = (exercises[leg] == ExerciseType::EUROPEAN) ? value : std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+}
+
+void BlackScholesEngine::accumulateGreeks(const OptionChain& chain, size_t group, size_t begin, size_t end,
+                                          double& value, Greeks& sum) const {
+    const OptionChain::ExpiryGroup& expiry = chain.getExpiryGroups()[group];
+    const OptionChain::Underlying& underlying = chain.getUnderlyings()[expiry.underlying];
+    accumulateGreeks(chain, group, begin, end, underlying.spot, expiry.rate, 0.0, value, sum);
+}
+
+void BlackScholesEngine::accumulateGreeks(const OptionChain& chain, size_t group, size_t begin, size_t end,
+                                          double spot, double rate, double volShift,
+                                          double& value, Greeks& sum) const {
+    const OptionChain::ExpiryGroup& expiry = chain.getExpiryGroups()[group];
+    const double* strikes = chain.strikes();
+    const double* vols = chain.volatilities();
+    const double* quantities = chain.quantities();
+    const OptionType* types = chain.types();
+    
+    // Legs are priced off the prepaid forward; dS/dspot is the dividend factor
+    double dividendFactor = expiry.dividendFactor;
+    double S = expiry.prepaidSpot(spot);
+    double r = rate;
+    double y = expiry.dividendYield;
+    double logS = std::log(S);
+    double T = expiry.timeToMaturity;
+    double sqrtT = expiry.sqrtT;
+    double rT = r * T;
+    double discountFactor = std::exp(-rT);
+    
+    double valueSum = 0.0, deltaSum = 0.0, gammaSum = 0.0, vegaSum = 0.0, thetaSum = 0.0, rhoSum = 0.0;
+    for (size_t leg = begin; leg < end; ++leg) {
+        double sigma = vols[leg] + volShift;
+        double q = quantities[leg];
+        double sigmaSqrtT = sigma * sqrtT;
+        double discountedStrike = strikes[leg] * discountFactor;
+        double d1 = (logS - std::log(strikes[leg]) + rT) / sigmaSqrtT + 0.5 * sigmaSqrtT;
+        double d2 = d1 - sigmaSqrtT;
+        
+        double phi = (types[leg] == OptionType::CALL) ? 1.0 : -1.0;
+        double nd1 = cumulativeNormalDistribution(phi * d1);
+        double nd2 = cumulativeNormalDistribution(phi * d2);
+        double pdf = normalProbabilityDensity(d1);
+        
+        valueSum += q * phi * (S * nd1 - discountedStrike * nd2);
+        deltaSum += q * phi * nd1;
+        gammaSum += q * pdf / (S * sigmaSqrtT);
+        vegaSum += q * S * sqrtT * pdf;
+        thetaSum += q * (-(S * pdf * sigma) / (2 * sqrtT) - phi * r * discountedStrike * nd2 + phi * y * S * nd1);
+        rhoSum += q * phi * T * discountedStrike * nd2;
+    }
+    
+    value += valueSum;
+    sum.delta += deltaSum * dividendFactor;
+    sum.gamma += gammaSum * dividendFactor * dividendFactor;
+    sum.vega += vegaSum / 100.0;
+    sum.theta += thetaSum / 365.0;
+    sum.rho += rhoSum / 100.0;
+}
+
+void BlackScholesEngine::accumulateScenarios(const OptionChain& chain, size_t group, size_t begin, size_t end,
+                                             const std::vector<double>& spotShocks,
+                                             const std::vector<double>& volShocks,
+                                             double& baseValue, double* values) const {
+    // Shocked vols are floored so deep negative vol shocks stay finite
+    const double minVolatility = 1e-4;
+    
+    const OptionChain::ExpiryGroup& expiry = chain.getExpiryGroups()[group];
+    const OptionChain::Underlying& underlying = chain.getUnderlyings()[expiry.underlying];
+    const double* strikes = chain.strikes();
+    const double* vols = chain.volatilities();
+    const double* quantities = chain.quantities();
+    const OptionType* types = chain.types();
+    
+    const size_t numSpots = spotShocks.size();
+    const size_t numVols = volShocks.size();
+    double sqrtT = expiry.sqrtT;
+    double rT = expiry.rate * expiry.timeToMaturity;
+    
+    // Shocked prepaid forwards and their logs are shared by every leg of the group
+    thread_local std::vector<double> shockedSpots;
+    thread_local std::vector<double> logSpots;
+    shockedSpots.resize(numSpots);
+    logSpots.resize(numSpots);
+    for (size_t i = 0; i < numSpots; ++i) {
+        shockedSpots[i] = expiry.prepaidSpot(underlying.spot * (1.0 + spotShocks[i]));
+        logSpots[i] = std::log(shockedSpots[i]);
+    }
+    double baseSpot = expiry.prepaidSpot(underlying.spot);
+    double logS = std::log(baseSpot);
+    
+    // Per-leg vol terms, rebuilt for each leg and reused across all spot shocks
+    thread_local std::vector<double> sigmaSqrtT;
+    thread_local std::vector<double> inverseSigmaSqrtT;
+    sigmaSqrtT.resize(numVols);
+    inverseSigmaSqrtT.resize(numVols);
+    
+    double baseSum = 0.0;
+    for (size_t leg = begin; leg < end; ++leg) {
+        double q = quantities[leg];
+        double phi = (types[leg] == OptionType::CALL) ? 1.0 : -1.0;
+        double discountedStrike = strikes[leg] * expiry.discountFactor;
+        double moneynessShift = rT - std::log(strikes[leg]);
+        
+        double baseSigmaSqrtT = vols[leg] * sqrtT;
+        double baseD1 = (logS + moneynessShift) / baseSigmaSqrtT + 0.5 * baseSigmaSqrtT;
+        baseSum += q * phi * (baseSpot * cumulativeNormalDistribution(phi * baseD1) -
+                              discountedStrike * cumulativeNormalDistribution(phi * (baseD1 - baseSigmaSqrtT)));
+        
+        for (size_t j = 0; j < numVols; ++j) {
+            sigmaSqrtT[j] = std::max(vols[leg] + volShocks[j], minVolatility) * sqrtT;
+            inverseSigmaSqrtT[j] = 1.0 / sigmaSqrtT[j];
+        }
+        
+        for (size_t i = 0; i < numSpots; ++i) {
+            double x = logSpots[i] + moneynessShift;
+            double S = shockedSpots[i];
+            double* row = values + i * numVols;
+            double spotOverStrike = S / discountedStrike;
+            for (size_t j = 0; j < numVols; ++j) {
+                double d1 = x * inverseSigmaSqrtT[j] + 0.5 * sigmaSqrtT[j];
+                double d2 = d1 - sigmaSqrtT[j];
+                
+                // n(d2) = n(d1) * S / (K e^{-rT}), so one exp serves both CDFs
+                // unless exp(-d1^2/2) has underflowed
+                double gaussian1 = std::exp(-0.5 * d1 * d1);
+                double gaussian2 = (gaussian1 > 0.0) ? gaussian1 * spotOverStrike : std::exp(-0.5 * d2 * d2);
+                row[j] += q * phi * (S * cumulativeNormalFromGaussian(phi * d1, gaussian1) -
+                                     discountedStrike * cumulativeNormalFromGaussian(phi * d2, gaussian2));
+            }
+        }
+    }
+    baseValue += baseSum;
+}
+
+void BlackScholesEngine::accumulateJointShocks(const OptionChain& chain, size_t group, size_t begin, size_t end,
+                                               const double* spotShocks, const double* volShocks, size_t count,
+                                               double* values) const {
+    const double minVolatility = 1e-4;
+    
+    const OptionChain::ExpiryGroup& expiry = chain.getExpiryGroups()[group];
+    const OptionChain::Underlying& underlying = chain.getUnderlyings()[expiry.underlying];
+    const double* strikes = chain.strikes();
+    const double* vols = chain.volatilities();
+    const double* quantities = chain.quantities();
+    const OptionType* types = chain.types();
+    
+    double sqrtT = expiry.sqrtT;
+    double rT = expiry.rate * expiry.timeToMaturity;
+    
+    thread_local std::vector<double> shockedSpots;
+    thread_local std::vector<double> logSpots;
+    shockedSpots.resize(count);
+    logSpots.resize(count);
+    for (size_t k = 0; k < count; ++k) {
+        shockedSpots[k] = expiry.prepaidSpot(underlying.spot * (1.0 + spotShocks[k]));
+        logSpots[k] = std::log(shockedSpots[k]);
+    }
+    
+    for (size_t leg = begin; leg < end; ++leg) {
+        double q = quantities[leg];
+        double phi = (types[leg] == OptionType::CALL) ? 1.0 : -1.0;
+        double discountedStrike = strikes[leg] * expiry.discountFactor;
+        double inverseDiscountedStrike = 1.0 / discountedStrike;
+        double moneynessShift = rT - std::log(strikes[leg]);
+        
+        for (size_t k = 0; k < count; ++k) {
+            double sigmaSqrtT = std::max(vols[leg] + volShocks[k], minVolatility) * sqrtT;
+            double d1 = (logSpots[k] + moneynessShift) / sigmaSqrtT + 0.5 * sigmaSqrtT;
+            double d2 = d1 - sigmaSqrtT;
+            
+            double gaussian1 = std::exp(-0.5 * d1 * d1);
+            double gaussian2 = (gaussian1 > 0.0) ? gaussian1 * shockedSpots[k] * inverseDiscountedStrike
+                                                 : std::exp(-0.5 * d2 * d2);
+            values[k] += q * phi * (shockedSpots[k] * cumulativeNormalFromGaussian(phi * d1, gaussian1) -
+                                    discountedStrike * cumulativeNormalFromGaussian(phi * d2, gaussian2));
+        }
+    }
+}
+
+void BlackScholesEngine::accumulatePathValues(const OptionChain& chain, size_t group, size_t begin, size_t end,
+                                              double elapsed, const double* spots, size_t count,
+                                              double* values) const {
+    const OptionChain::ExpiryGroup& expiry = chain.getExpiryGroups()[group];
+    const OptionChain::Underlying& underlying = chain.getUnderlyings()[expiry.underlying];
+    const double* strikes = chain.strikes();
+    const double* vols = chain.volatilities();
+    const double* quantities = chain.quantities();
+    const OptionType* types = chain.types();
+    
+    double remaining = expiry.timeToMaturity - elapsed;
+    if (remaining <= 0.0) {
+        throw std::invalid_argument("Expiry group has already expired at the valuation time");
+    }
+    
+    // Carry over [elapsed, T]: forward discount and dividend factors, and the
+    // cash dividends still due, valued at elapsed
+    double elapsedDiscount = std::exp(-expiry.rate * elapsed);
+    double elapsedDividendFactor = std::exp(-expiry.dividendYield * elapsed);
+    double elapsedDividendPV = 0.0;
+    if (underlying.termStructure) {
+        TermStructure::Factors factors = underlying.termStructure->factorsAt(elapsed);
+        elapsedDiscount = factors.discountFactor;
+        elapsedDividendFactor = factors.dividendFactor;
+        elapsedDividendPV = factors.dividendPV;
+    }
+    double discountFactor = expiry.discountFactor / elapsedDiscount;
+    double dividendFactor = expiry.dividendFactor / elapsedDividendFactor;
+    double remainingDividends = (expiry.dividendPV - elapsedDividendPV) / elapsedDiscount;
+    double sqrtT = std::sqrt(remaining);
+    double rT = -std::log(discountFactor);
+    
+    thread_local std::vector<double> prepaidSpots;
+    thread_local std::vector<double> logSpots;
+    prepaidSpots.resize(count);
+    logSpots.resize(count);
+    for (size_t k = 0; k < count; ++k) {
+        prepaidSpots[k] = std::max(spots[k] - remainingDividends, 0.0) * dividendFactor;
+        logSpots[k] = std::log(prepaidSpots[k]);
+    }
+    
+    for (size_t leg = begin; leg < end; ++leg) {
+        double q = quantities[leg];
+        double phi = (types[leg] == OptionType::CALL) ? 1.0 : -1.0;
+        double discountedStrike = strikes[leg] * discountFactor;
+        double inverseDiscountedStrike = 1.0 / discountedStrike;
+        double moneynessShift = rT - std::log(strikes[leg]);
+        double sigmaSqrtT = vols[leg] * sqrtT;
+        double inverseSigmaSqrtT = 1.0 / sigmaSqrtT;
+        
+        for (size_t k = 0; k < count; ++k) {
+            double d1 = (logSpots[k] + moneynessShift) * inverseSigmaSqrtT + 0.5 * sigmaSqrtT;
+            double d2 = d1 - sigmaSqrtT;
+            
+            double gaussian1 = std::exp(-0.5 * d1 * d1);
+            double gaussian2 = (gaussian1 > 0.0) ? gaussian1 * prepaidSpots[k] * inverseDiscountedStrike
+                                                 : std::exp(-0.5 * d2 * d2);
+            values[k] += q * phi * (prepaidSpots[k] * cumulativeNormalFromGaussian(phi * d1, gaussian1) -
+                                    discountedStrike * cumulativeNormalFromGaussian(phi * d2, gaussian2));
+        }
+    }
+}
+
+void BlackScholesEngine::pathDeltas(const Option& option, double elapsed, const double* spots, size_t count,
+                                    double* deltas) const {
+    double remaining = option.getTimeToMaturity() - elapsed;
+    if (remaining <= 0.0) {
+        throw std::invalid_argument("Option has already expired at the valuation time");
+    }
+    double sigmaSqrtT = option.getVolatility() * std::sqrt(remaining);
+    double inverseSigmaSqrtT = 1.0 / sigmaSqrtT;
+    double moneynessShift = (option.getRate() - option.getDividendYield()) * remaining - std::log(option.getStrike());
+    double dividendFactor = std::exp(-option.getDividendYield() * remaining);
+    double phi = (option.getOptionType() == OptionType::CALL) ? 1.0 : -1.0;
+    double scale = phi * dividendFactor;
+    
+    // d1, its Gaussian and N(phi d1) in one pass per spot
+    for (size_t k = 0; k < count; ++k) {
+        double d1 = (std::log(spots[k]) + moneynessShift) * inverseSigmaSqrtT + 0.5 * sigmaSqrtT;
+        deltas[k] = scale * cumulativeNormalFromGaussian(phi * d1, std::exp(-0.5 * d1 * d1));
     }
 }
 
-std::pair<double, double> BlackScholesEngine::calculateD1D2(const Option& option) {
+std::pair<double, double> BlackScholesEngine::calculateD1D2(const Option& option) const {
     double S = option.getSpot();
     double K = option.getStrike();
     double r = option.getRate();
     double sigma = option.getVolatility();
     double T = option.getTimeToMaturity();
     
-    double d1 = (std::log(S / K) + (r + 0.5 * sigma * sigma) * T) / (sigma * std::sqrt(T));
+    double q = option.getDividendYield();
+    
+    double d1 = (std::log(S / K) + (r - q + 0.5 * sigma * sigma) * T) / (sigma * std::sqrt(T));
     double d2 = d1 - sigma * std::sqrt(T);
     
     return std::make_pair(d1, d2);
 }
 
-double BlackScholesEngine::cumulativeNormalDistribution(double x) {
+double BlackScholesEngine::cumulativeNormalDistribution(double x) const {
     const double a1 =  0.254829592;
     const double a2 = -0.284496736;
     const double a3 =  1.421413741;
@@ -53,32 +372,52 @@ double BlackScholesEngine::cumulativeNormalDistribution(double x) {
     return 0.5 * (1.0 + sign * y);
 }
 
-double BlackScholesEngine::normalProbabilityDensity(double x) {
+double BlackScholesEngine::cumulativeNormalFromGaussian(double x, double gaussian) const {
+    // Same approximation as cumulativeNormalDistribution with exp(-x^2/2) supplied
+    const double a1 =  0.254829592;
+    const double a2 = -0.284496736;
+    const double a3 =  1.421413741;
+    const double a4 = -1.453152027;
+    const double a5 =  1.061405429;
+    const double p  =  0.3275911;
+    
+    double t = 1.0 / (1.0 + p * std::abs(x) * M_SQRT1_2);
+    double y = 1.0 - (((((a5 * t + a4) * t) + a3) * t + a2) * t + a1) * t * gaussian;
+    
+    return (x >= 0) ? 0.5 * (1.0 + y) : 0.5 * (1.0 - y);
+}
+
+double BlackScholesEngine::dividendDiscount(const Option& option) const {
+    double q = option.getDividendYield();
+    return (q == 0.0) ? 1.0 : std::exp(-q * option.getTimeToMaturity());
+}
+
+double BlackScholesEngine::normalProbabilityDensity(double x) const {
     return std::exp(-0.5 * x * x) / std::sqrt(2.0 * M_PI);
 }
 
-double BlackScholesEngine::delta(const Option& option) {
+double BlackScholesEngine::delta(const Option& option) const {
     // C++14 compatible - no structured binding
     std::pair<double, double> d_values = calculateD1D2(option);
     double d1 = d_values.first;
     
     if (option.getOptionType() == OptionType::CALL) {
-        return cumulativeNormalDistribution(d1);
+        return dividendDiscount(option) * cumulativeNormalDistribution(d1);
     } else {
-        return cumulativeNormalDistribution(d1) - 1.0;
+        return dividendDiscount(option) * (cumulativeNormalDistribution(d1) - 1.0);
     }
 }
 
-double BlackScholesEngine::gamma(const Option& option) {
+double BlackScholesEngine::gamma(const Option& option) const {
     // C++14 compatible - no structured binding
     std::pair<double, double> d_values = calculateD1D2(option);
     double d1 = d_values.first;
     
-    return normalProbabilityDensity(d1) / 
+    return dividendDiscount(option) * normalProbabilityDensity(d1) / 
            (option.getSpot() * option.getVolatility() * std::sqrt(option.getTimeToMaturity()));
 }
 
-double BlackScholesEngine::theta(const Option& option) {
+double BlackScholesEngine::theta(const Option& option) const {
     // C++14 compatible - no structured binding
     std::pair<double, double> d_values = calculateD1D2(option);
     double d1 = d_values.first;
@@ -90,18 +429,23 @@ double BlackScholesEngine::theta(const Option& option) {
     double sigma = option.getVolatility();
     double T = option.getTimeToMaturity();
     
-    double term1 = -(S * normalProbabilityDensity(d1) * sigma) / (2 * std::sqrt(T));
+    double q = option.getDividendYield();
+    double discountedSpot = S * dividendDiscount(option);
+    
+    double term1 = -(discountedSpot * normalProbabilityDensity(d1) * sigma) / (2 * std::sqrt(T));
     
     if (option.getOptionType() == OptionType::CALL) {
         double term2 = r * K * std::exp(-r * T) * cumulativeNormalDistribution(d2);
-        return (term1 - term2) / 365.0;
+        double term3 = q * discountedSpot * cumulativeNormalDistribution(d1);
+        return (term1 - term2 + term3) / 365.0;
     } else {
         double term2 = r * K * std::exp(-r * T) * cumulativeNormalDistribution(-d2);
-        return (term1 + term2) / 365.0;
+        double term3 = q * discountedSpot * cumulativeNormalDistribution(-d1);
+        return (term1 + term2 - term3) / 365.0;
     }
 }
 
-double BlackScholesEngine::vega(const Option& option) {
+double BlackScholesEngine::vega(const Option& option) const {
     // C++14 compatible - no structured binding
     std::pair<double, double> d_values = calculateD1D2(option);
     double d1 = d_values.first;
@@ -109,10 +453,10 @@ double BlackScholesEngine::vega(const Option& option) {
     double S = option.getSpot();
     double T = option.getTimeToMaturity();
     
-    return S * std::sqrt(T) * normalProbabilityDensity(d1) / 100.0;
+    return S * dividendDiscount(option) * std::sqrt(T) * normalProbabilityDensity(d1) / 100.0;
 }
 
-double BlackScholesEngine::rho(const Option& option) {
+double BlackScholesEngine::rho(const Option& option) const {
     // C++14 compatible - no structured binding
     std::pair<double, double> d_values = calculateD1D2(option);
     double d2 = d_values.second;
@@ -127,3 +471,39 @@ double BlackScholesEngine::rho(const Option& option) {
         return -K * T * std::exp(-r * T) * cumulativeNormalDistribution(-d2) / 100.0;
     }
 }
+
+void BlackScholesEngine::greeks(const Option& option, Greeks& out) const {
+    std::pair<double, double> d_values = calculateD1D2(option);
+    double d1 = d_values.first;
+    double d2 = d_values.second;
+    
+    double S = option.getSpot();
+    double K = option.getStrike();
+    double r = option.getRate();
+    double sigma = option.getVolatility();
+    double T = option.getTimeToMaturity();
+    
+    double q = option.getDividendYield();
+    double sqrtT = std::sqrt(T);
+    double discountedStrike = K * std::exp(-r * T);
+    double carry = dividendDiscount(option);
+    double discountedSpot = S * carry;
+    double pdf = normalProbabilityDensity(d1);
+    double nd1 = cumulativeNormalDistribution(d1);
+    
+    out.gamma = carry * pdf / (S * sigma * sqrtT);
+    out.vega = discountedSpot * sqrtT * pdf / 100.0;
+    
+    double term1 = -(discountedSpot * pdf * sigma) / (2 * sqrtT);
+    if (option.getOptionType() == OptionType::CALL) {
+        double nd2 = cumulativeNormalDistribution(d2);
+        out.delta = carry * nd1;
+        out.theta = (term1 - r * discountedStrike * nd2 + q * discountedSpot * nd1) / 365.0;
+        out.rho = T * discountedStrike * nd2 / 100.0;
+    } else {
+        double nMinusD2 = cumulativeNormalDistribution(-d2);
+        out.delta = carry * (nd1 - 1.0);
+        out.theta = (term1 + r * discountedStrike * nMinusD2 - q * discountedSpot * (1.0 - nd1)) / 365.0;
+        out.rho = -T * discountedStrike * nMinusD2 / 100.0;
+    }
+}
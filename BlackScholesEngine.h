@@ -3,24 +3,74 @@
 #define BLACK_SCHOLES_ENGINE_H
 
 #include "PricingEngine.h"
+#include "PricingTypes.h"
 #include <cmath>
+#include <vector>
 
 class BlackScholesEngine : public PricingEngine {
 public:
-    double price(const Option& option) override;
+    using PricingEngine::price;
+    double price(const Option& option, const PricingConfig& config) const override;
     std::string getMethodName() const override { return "Black-Scholes"; }
     
+    // Shares the forward, discount factor and sqrt(T) across each expiry group
+    void priceChain(const OptionChain& chain, const PricingConfig& config, std::vector<double>& out) const override;
+    
+    // Quantity-weighted value and Greeks summed over legs [begin, end) of one expiry
+    // group, in the same units as greeks(). American legs use the European Greeks.
+    void accumulateGreeks(const OptionChain& chain, size_t group, size_t begin, size_t end,
+                          double& value, Greeks& sum) const;
+    
+    // Same, with the group's spot and rate overridden and its leg vols shifted
+    void accumulateGreeks(const OptionChain& chain, size_t group, size_t begin, size_t end,
+                          double spot, double rate, double volShift, double& value, Greeks& sum) const;
+    
+    // Quantity-weighted value of legs [begin, end) of one expiry group under every
+    // (relative spot shock, absolute vol shock) pair, added into the dense
+    // values[spot * volShocks.size() + vol]. The unshocked value goes to baseValue.
+    void accumulateScenarios(const OptionChain& chain, size_t group, size_t begin, size_t end,
+                             const std::vector<double>& spotShocks, const std::vector<double>& volShocks,
+                             double& baseValue, double* values) const;
+    
+    // Quantity-weighted value of legs [begin, end) of one expiry group under count
+    // paired shocks (spotShocks[k] relative, volShocks[k] absolute), added into values[k]
+    void accumulateJointShocks(const OptionChain& chain, size_t group, size_t begin, size_t end,
+                               const double* spotShocks, const double* volShocks, size_t count,
+                               double* values) const;
+    
+    // Quantity-weighted value at time elapsed of legs [begin, end) of one expiry
+    // group, for count spot levels of its underlying, added into values[k]. Legs
+    // must not have expired (elapsed < group expiry). Discounting and dividend
+    // yield use the forward carry over [elapsed, T] from the underlying's term
+    // structure, and cash dividends still due by expiry are escrowed from each spot.
+    void accumulatePathValues(const OptionChain& chain, size_t group, size_t begin, size_t end,
+                              double elapsed, const double* spots, size_t count, double* values) const;
+    
+    // Spot delta of the option at time elapsed (before its expiry) for count spot
+    // levels, written to deltas[k]. Rate, dividend yield and volatility are the
+    // option's own; American options get the European delta.
+    void pathDeltas(const Option& option, double elapsed, const double* spots, size_t count,
+                    double* deltas) const;
+    
     // Greeks calculation
-    double delta(const Option& option);
-    double gamma(const Option& option);
-    double theta(const Option& option);
-    double vega(const Option& option);
-    double rho(const Option& option);
+    double delta(const Option& option) const;
+    double gamma(const Option& option) const;
+    double theta(const Option& option) const;
+    double vega(const Option& option) const;
+    double rho(const Option& option) const;
+    
+    // All Greeks from a single d1/d2 evaluation
+    void greeks(const Option& option, Greeks& out) const;
 
 private:
-    double cumulativeNormalDistribution(double x);
-    double normalProbabilityDensity(double x);
-    std::pair<double, double> calculateD1D2(const Option& option);
+    template <OptionType Type>
+    double priceKernel(const Option& option) const;
+    
+    double cumulativeNormalDistribution(double x) const;
+    double cumulativeNormalFromGaussian(double x, double gaussian) const;
+    double normalProbabilityDensity(double x) const;
+    double dividendDiscount(const Option& option) const;
+    std::pair<double, double> calculateD1D2(const Option& option) const;
 };
 
 #endif
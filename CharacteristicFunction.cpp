@@ -0,0 +1,90 @@
+#include "CharacteristicFunction.h"
+#include <cmath>
+
+namespace {
+const std::complex<double> I(0.0, 1.0);
+}
+
+CharacteristicFunction::Cumulants CharacteristicFunction::cumulants(double rate, double timeToMaturity) const {
+    // log(phi(u)) = i*c1*u - c2*u^2/2 + ..., so central differences around zero
+    const double h = 1e-3;
+    std::complex<double> logUp = std::log(evaluate(h, rate, timeToMaturity));
+    std::complex<double> logDown = std::log(evaluate(-h, rate, timeToMaturity));
+
+    Cumulants result;
+    result.c1 = (logUp - logDown).imag() / (2.0 * h);
+    result.c2 = -(logUp + logDown).real() / (h * h);
+    result.c4 = 0.0;
+    return result;
+}
+
+std::complex<double> BlackScholesModel::evaluate(std::complex<double> u, double rate, double timeToMaturity) const {
+    double drift = (rate - 0.5 * sigma_ * sigma_) * timeToMaturity;
+    return std::exp(I * u * drift - 0.5 * sigma_ * sigma_ * timeToMaturity * u * u);
+}
+
+CharacteristicFunction::Cumulants BlackScholesModel::cumulants(double rate, double timeToMaturity) const {
+    Cumulants result;
+    result.c1 = (rate - 0.5 * sigma_ * sigma_) * timeToMaturity;
+    result.c2 = sigma_ * sigma_ * timeToMaturity;
+    result.c4 = 0.0;
+    return result;
+}
+
+std::complex<double> MertonJumpModel::evaluate(std::complex<double> u, double rate, double timeToMaturity) const {
+    double k = std::exp(muJ_ + 0.5 * deltaJ_ * deltaJ_) - 1.0;
+    double drift = (rate - 0.5 * sigma_ * sigma_ - lambda_ * k) * timeToMaturity;
+    std::complex<double> jumpTerm = std::exp(I * u * muJ_ - 0.5 * deltaJ_ * deltaJ_ * u * u) - 1.0;
+
+    return std::exp(I * u * drift - 0.5 * sigma_ * sigma_ * timeToMaturity * u * u +
+                    lambda_ * timeToMaturity * jumpTerm);
+}
+
+CharacteristicFunction::Cumulants MertonJumpModel::cumulants(double rate, double timeToMaturity) const {
+    double k = std::exp(muJ_ + 0.5 * deltaJ_ * deltaJ_) - 1.0;
+    double mu2 = muJ_ * muJ_;
+    double d2 = deltaJ_ * deltaJ_;
+
+    Cumulants result;
+    result.c1 = (rate - 0.5 * sigma_ * sigma_ - lambda_ * k + lambda_ * muJ_) * timeToMaturity;
+    result.c2 = (sigma_ * sigma_ + lambda_ * (mu2 + d2)) * timeToMaturity;
+    result.c4 = lambda_ * timeToMaturity * (mu2 * mu2 + 6.0 * d2 * mu2 + 3.0 * d2 * d2);
+    return result;
+}
+
+std::complex<double> HestonModel::evaluate(std::complex<double> u, double rate, double timeToMaturity) const {
+    // "Little Heston trap" formulation (Albrecher et al.), stable for long maturities
+    std::complex<double> beta = kappa_ - rho_ * xi_ * I * u;
+    std::complex<double> d = std::sqrt(beta * beta + xi_ * xi_ * (I * u + u * u));
+    std::complex<double> g = (beta - d) / (beta + d);
+    std::complex<double> expDT = std::exp(-d * timeToMaturity);
+
+    std::complex<double> C = I * u * rate * timeToMaturity +
+        kappa_ * theta_ / (xi_ * xi_) *
+        ((beta - d) * timeToMaturity - 2.0 * std::log((1.0 - g * expDT) / (1.0 - g)));
+    std::complex<double> D = (beta - d) / (xi_ * xi_) * (1.0 - expDT) / (1.0 - g * expDT);
+
+    return std::exp(C + D * v0_);
+}
+
+double VarianceGammaModel::martingaleCorrection() const {
+    return std::log(1.0 - theta_ * nu_ - 0.5 * sigma_ * sigma_ * nu_) / nu_;
+}
+
+std::complex<double> VarianceGammaModel::evaluate(std::complex<double> u, double rate, double timeToMaturity) const {
+    double drift = (rate + martingaleCorrection()) * timeToMaturity;
+    std::complex<double> base = 1.0 - I * u * theta_ * nu_ + 0.5 * sigma_ * sigma_ * nu_ * u * u;
+
+    return std::exp(I * u * drift - (timeToMaturity / nu_) * std::log(base));
+}
+
+CharacteristicFunction::Cumulants VarianceGammaModel::cumulants(double rate, double timeToMaturity) const {
+    double s2 = sigma_ * sigma_;
+    double t2 = theta_ * theta_;
+
+    Cumulants result;
+    result.c1 = (rate + martingaleCorrection() + theta_) * timeToMaturity;
+    result.c2 = (s2 + nu_ * t2) * timeToMaturity;
+    result.c4 = 3.0 * (s2 * s2 * nu_ + 2.0 * t2 * t2 * nu_ * nu_ * nu_ + 4.0 * s2 * t2 * nu_ * nu_) * timeToMaturity;
+    return result;
+}
@@ -0,0 +1,80 @@
+// CharacteristicFunction.h
+#ifndef CHARACTERISTIC_FUNCTION_H
+#define CHARACTERISTIC_FUNCTION_H
+
+#include <complex>
+#include <string>
+
+// Risk-neutral characteristic function of the log-return X = ln(S_T / S_0).
+// Any model implementing this interface can be priced by the FourierEngine.
+class CharacteristicFunction {
+public:
+    struct Cumulants {
+        double c1, c2, c4;
+    };
+
+    virtual ~CharacteristicFunction() = default;
+
+    // E[exp(i u X)] for a (possibly complex) argument u
+    virtual std::complex<double> evaluate(std::complex<double> u, double rate, double timeToMaturity) const = 0;
+    virtual std::string getModelName() const = 0;
+
+    // Cumulants of X used to size the COS truncation range. The default
+    // differentiates the log characteristic function numerically.
+    virtual Cumulants cumulants(double rate, double timeToMaturity) const;
+};
+
+class BlackScholesModel : public CharacteristicFunction {
+public:
+    BlackScholesModel(double volatility) : sigma_(volatility) {}
+
+    std::complex<double> evaluate(std::complex<double> u, double rate, double timeToMaturity) const override;
+    std::string getModelName() const override { return "Black-Scholes"; }
+    Cumulants cumulants(double rate, double timeToMaturity) const override;
+
+private:
+    double sigma_;
+};
+
+// Lognormal jumps with intensity lambda, mean log-jump mu and log-jump volatility delta
+class MertonJumpModel : public CharacteristicFunction {
+public:
+    MertonJumpModel(double volatility, double lambda, double jumpMean, double jumpVolatility)
+        : sigma_(volatility), lambda_(lambda), muJ_(jumpMean), deltaJ_(jumpVolatility) {}
+
+    std::complex<double> evaluate(std::complex<double> u, double rate, double timeToMaturity) const override;
+    std::string getModelName() const override { return "Merton Jump-Diffusion"; }
+    Cumulants cumulants(double rate, double timeToMaturity) const override;
+
+private:
+    double sigma_, lambda_, muJ_, deltaJ_;
+};
+
+class HestonModel : public CharacteristicFunction {
+public:
+    HestonModel(double v0, double kappa, double theta, double volOfVol, double correlation)
+        : v0_(v0), kappa_(kappa), theta_(theta), xi_(volOfVol), rho_(correlation) {}
+
+    std::complex<double> evaluate(std::complex<double> u, double rate, double timeToMaturity) const override;
+    std::string getModelName() const override { return "Heston"; }
+
+private:
+    double v0_, kappa_, theta_, xi_, rho_;
+};
+
+class VarianceGammaModel : public CharacteristicFunction {
+public:
+    VarianceGammaModel(double sigma, double nu, double theta)
+        : sigma_(sigma), nu_(nu), theta_(theta) {}
+
+    std::complex<double> evaluate(std::complex<double> u, double rate, double timeToMaturity) const override;
+    std::string getModelName() const override { return "Variance Gamma"; }
+    Cumulants cumulants(double rate, double timeToMaturity) const override;
+
+private:
+    double sigma_, nu_, theta_;
+
+    double martingaleCorrection() const;
+};
+
+#endif
@@ -0,0 +1,136 @@
+#include "DeltaHedgeEngine.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+const size_t DeltaHedgeEngine::PATH_BLOCK;
+
+DeltaHedgeEngine::DeltaHedgeEngine(ThreadPool& pool) : pool_(pool) {}
+
+HedgeErrorDistribution DeltaHedgeEngine::simulate(const Option& option, const DeltaHedgeSettings& settings) {
+    if (option.getSpot() <= 0.0 || option.getStrike() <= 0.0 || option.getVolatility() <= 0.0 ||
+        option.getTimeToMaturity() <= 0.0) {
+        throw std::invalid_argument("Hedged option needs a positive spot, strike, volatility and maturity");
+    }
+    if (settings.numPaths == 0 || settings.rebalances == 0) {
+        throw std::invalid_argument("Need at least one path and one rebalance");
+    }
+    if (settings.realizedVolatility < 0.0 || settings.transactionCost < 0.0) {
+        throw std::invalid_argument("Realized volatility and transaction cost must be non-negative");
+    }
+    if (settings.lossQuantile <= 0.0 || settings.lossQuantile >= 1.0) {
+        throw std::invalid_argument("Loss quantile must lie in (0, 1)");
+    }
+    
+    const Option european(option.getSpot(), option.getStrike(), option.getRate(), option.getVolatility(),
+                          option.getTimeToMaturity(), option.getOptionType(), ExerciseType::EUROPEAN,
+                          option.getDividendYield());
+    const double spot = option.getSpot();
+    const double strike = option.getStrike();
+    const double rate = option.getRate();
+    const double dividendYield = option.getDividendYield();
+    const double maturity = option.getTimeToMaturity();
+    const double volatility = settings.realizedVolatility > 0.0 ? settings.realizedVolatility : option.getVolatility();
+    const double phi = (option.getOptionType() == OptionType::CALL) ? 1.0 : -1.0;
+    const double cost = settings.transactionCost;
+    
+    // Dates after inception: rebalances - 1 trades, then expiry
+    const size_t numDates = settings.rebalances;
+    const double dt = maturity / numDates;
+    std::vector<double> timeGrid(numDates);
+    for (size_t date = 0; date < numDates; ++date) {
+        timeGrid[date] = (date + 1) * dt;
+    }
+    timeGrid.back() = maturity;
+    const double growth = std::exp(rate * dt);
+    const double dividendAccrual = std::exp(dividendYield * dt) - 1.0;
+    const double discountFactor = std::exp(-rate * maturity);
+    
+    // Inception is the same on every path
+    double premium = blackScholesEngine_.price(european);
+    double initialDelta;
+    blackScholesEngine_.pathDeltas(european, 0.0, &spot, 1, &initialDelta);
+    double initialCost = cost * std::abs(initialDelta) * spot;
+    double initialCash = premium - initialDelta * spot - initialCost;
+    
+    const size_t numPaths = settings.numPaths;
+    size_t numBlocks = (numPaths + PATH_BLOCK - 1) / PATH_BLOCK;
+    std::vector<double> errors(numPaths);
+    std::vector<double> blockCosts(numBlocks, 0.0);  // per block, so the sum does not depend on the thread count
+    
+    pool_.parallelFor(numBlocks, 1, [&](size_t firstBlock, size_t lastBlock) {
+        std::vector<double> spots(numDates * PATH_BLOCK);
+        std::vector<double> deltas(PATH_BLOCK), newDeltas(PATH_BLOCK), cash(PATH_BLOCK);
+        std::normal_distribution<double> normal(0.0, 1.0);
+        
+        for (size_t block = firstBlock; block < lastBlock; ++block) {
+            size_t first = block * PATH_BLOCK;
+            size_t count = std::min(PATH_BLOCK, numPaths - first);
+            
+            // Streams depend only on (seed, block), so results do not depend on the thread count
+            std::seed_seq sequence{ settings.seed, static_cast<unsigned>(block) };
+            std::mt19937 generator(sequence);
+            
+            for (size_t i = 0; i < numDates * count; ++i) {
+                spots[i] = normal(generator);
+            }
+            monteCarloEngine_.evolvePaths(spot, rate - dividendYield, volatility, timeGrid, count, spots.data());
+            
+            std::fill(deltas.begin(), deltas.begin() + count, initialDelta);
+            std::fill(cash.begin(), cash.begin() + count, initialCash);
+            double costSum = initialCost * count;
+            
+            for (size_t date = 0; date + 1 < numDates; ++date) {
+                const double* row = &spots[date * count];
+                const double* previous = date > 0 ? row - count : nullptr;
+                blackScholesEngine_.pathDeltas(european, timeGrid[date], row, count, newDeltas.data());
+                
+                double tradeDiscount = std::exp(-rate * timeGrid[date]);
+                double tradeCosts = 0.0;
+                for (size_t k = 0; k < count; ++k) {
+                    double held = previous ? previous[k] : spot;
+                    double trade = newDeltas[k] - deltas[k];
+                    double tradeCost = cost * std::abs(trade) * row[k];
+                    cash[k] = cash[k] * growth + deltas[k] * held * dividendAccrual - trade * row[k] - tradeCost;
+                    deltas[k] = newDeltas[k];
+                    tradeCosts += tradeCost;
+                }
+                costSum += tradeCosts * tradeDiscount;
+            }
+            
+            // Expiry: carry the last step, then settle stock against the payoff
+            const double* row = &spots[(numDates - 1) * count];
+            const double* previous = numDates > 1 ? row - count : nullptr;
+            for (size_t k = 0; k < count; ++k) {
+                double held = previous ? previous[k] : spot;
+                double terminal = cash[k] * growth + deltas[k] * held * dividendAccrual + deltas[k] * row[k] -
+                                  std::max(phi * (row[k] - strike), 0.0);
+                errors[first + k] = terminal * discountFactor;
+            }
+            blockCosts[block] = costSum;
+        }
+    });
+    
+    HedgeErrorDistribution distribution;
+    distribution.premium = premium;
+    
+    double sum = 0.0, sumSquares = 0.0, costSum = 0.0;
+    for (size_t path = 0; path < numPaths; ++path) {
+        sum += errors[path];
+        sumSquares += errors[path] * errors[path];
+    }
+    for (size_t block = 0; block < numBlocks; ++block) {
+        costSum += blockCosts[block];
+    }
+    distribution.mean = sum / numPaths;
+    distribution.standardDeviation = std::sqrt(std::max(sumSquares / numPaths - distribution.mean * distribution.mean, 0.0));
+    distribution.meanTransactionCost = costSum / numPaths;
+    
+    std::sort(errors.begin(), errors.end());
+    size_t quantileIndex = std::min(numPaths - 1, static_cast<size_t>((1.0 - settings.lossQuantile) * numPaths));
+    distribution.valueAtRisk = -errors[quantileIndex];
+    distribution.errors.swap(errors);
+    
+    return distribution;
+}
@@ -0,0 +1,116 @@
+#include "ExposureEngine.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+ExposureEngine::ExposureEngine(ThreadPool& pool) : pool_(pool) {}
+
+ExposureProfile ExposureEngine::compute(const OptionChain& book, const std::vector<double>& timeGrid,
+                                        const ExposureSettings& settings) {
+    if (!book.isFinalized()) {
+        throw std::logic_error("OptionChain must be finalized before exposure simulation");
+    }
+    const std::vector<OptionChain::Underlying>& underlyings = book.getUnderlyings();
+    const std::vector<OptionChain::ExpiryGroup>& groups = book.getExpiryGroups();
+    if (settings.volatilities.size() != underlyings.size()) {
+        throw std::invalid_argument("Need a simulation volatility for every underlying");
+    }
+    if (settings.numPaths == 0 || timeGrid.empty()) {
+        throw std::invalid_argument("Need at least one path and one date");
+    }
+    if (settings.correlation < 0.0 || settings.correlation > 1.0) {
+        throw std::invalid_argument("Correlation must lie in [0, 1]");
+    }
+    if (settings.pfeQuantile <= 0.0 || settings.pfeQuantile >= 1.0) {
+        throw std::invalid_argument("PFE quantile must lie in (0, 1)");
+    }
+    if (timeGrid[0] <= 0.0) {
+        throw std::invalid_argument("Time grid must start after today");
+    }
+    
+    const size_t numDates = timeGrid.size();
+    const size_t numPaths = settings.numPaths;
+    
+    // Paths drift along each underlying's forward curve, matching the forward
+    // carry accumulatePathValues revalues with
+    std::vector<std::vector<double>> forwards(underlyings.size(), std::vector<double>(numDates));
+    for (size_t u = 0; u < underlyings.size(); ++u) {
+        for (size_t date = 0; date < numDates; ++date) {
+            forwards[u][date] = underlyings[u].termStructure
+                ? underlyings[u].termStructure->factorsAt(timeGrid[date]).forward(underlyings[u].spot)
+                : underlyings[u].spot * std::exp(underlyings[u].rate * timeGrid[date]);
+        }
+    }
+    
+    std::vector<double> values(numDates * numPaths, 0.0);  // [date * numPaths + path]
+    size_t numBlocks = (numPaths + PATH_BLOCK - 1) / PATH_BLOCK;
+    
+    pool_.parallelFor(numBlocks, 1, [&](size_t firstBlock, size_t lastBlock) {
+        double commonWeight = std::sqrt(settings.correlation);
+        double idiosyncraticWeight = std::sqrt(1.0 - settings.correlation);
+        std::vector<double> common(numDates * PATH_BLOCK);
+        std::vector<std::vector<double>> spots(underlyings.size(), std::vector<double>(numDates * PATH_BLOCK));
+        std::vector<double> blockValues(numDates * PATH_BLOCK);
+        std::normal_distribution<double> normal(0.0, 1.0);
+        
+        for (size_t block = firstBlock; block < lastBlock; ++block) {
+            size_t first = block * PATH_BLOCK;
+            size_t count = std::min(PATH_BLOCK, numPaths - first);
+            
+            // Streams depend only on (seed, block), so results do not depend on the thread count
+            std::seed_seq sequence{ settings.seed, static_cast<unsigned>(block) };
+            std::mt19937 generator(sequence);
+            
+            for (size_t i = 0; i < numDates * count; ++i) {
+                common[i] = normal(generator);
+            }
+            for (size_t u = 0; u < underlyings.size(); ++u) {
+                for (size_t i = 0; i < numDates * count; ++i) {
+                    spots[u][i] = commonWeight * common[i] + idiosyncraticWeight * normal(generator);
+                }
+                monteCarloEngine_.evolvePaths(underlyings[u].spot, forwards[u], settings.volatilities[u],
+                                              timeGrid, count, spots[u].data());
+            }
+            
+            std::fill(blockValues.begin(), blockValues.end(), 0.0);
+            for (size_t date = 0; date < numDates; ++date) {
+                for (size_t g = 0; g < groups.size(); ++g) {
+                    if (groups[g].timeToMaturity <= timeGrid[date]) {
+                        continue;
+                    }
+                    blackScholesEngine_.accumulatePathValues(book, g, groups[g].begin, groups[g].end, timeGrid[date],
+                                                             &spots[groups[g].underlying][date * count], count,
+                                                             &blockValues[date * count]);
+                }
+                std::copy(blockValues.begin() + date * count, blockValues.begin() + (date + 1) * count,
+                          values.begin() + date * numPaths + first);
+            }
+        }
+    });
+    
+    ExposureProfile profile;
+    profile.times = timeGrid;
+    profile.expectedValue.resize(numDates);
+    profile.expectedExposure.resize(numDates);
+    profile.potentialFutureExposure.resize(numDates);
+    
+    size_t quantileIndex = std::min(numPaths - 1, static_cast<size_t>(std::ceil(settings.pfeQuantile * numPaths)) - 1);
+    std::vector<double> exposures(numPaths);
+    for (size_t date = 0; date < numDates; ++date) {
+        const double* row = &values[date * numPaths];
+        double valueSum = 0.0, exposureSum = 0.0;
+        for (size_t path = 0; path < numPaths; ++path) {
+            valueSum += row[path];
+            exposures[path] = std::max(row[path], 0.0);
+            exposureSum += exposures[path];
+        }
+        std::nth_element(exposures.begin(), exposures.begin() + quantileIndex, exposures.end());
+        
+        profile.expectedValue[date] = valueSum / numPaths;
+        profile.expectedExposure[date] = exposureSum / numPaths;
+        profile.potentialFutureExposure[date] = exposures[quantileIndex];
+    }
+    
+    return profile;
+}
@@ -0,0 +1,296 @@
+#include "FourierEngine.h"
+#include "OptionChain.h"
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <limits>
+#include <numeric>
+
+double FourierEngine::price(const Option& quoted, const PricingConfig& config) const {
+    const Option option = resolveMarketData(quoted, config);
+    if (option.getExerciseType() == ExerciseType::AMERICAN) {
+        throw std::invalid_argument("Fourier pricing only supports European options");
+    }
+
+    // A single strike has nothing to share across a grid, so use the COS
+    // expansion directly without any intermediate buffers
+    BlackScholesModel model(option.getVolatility());
+    double spot = option.getSpot();
+    double K = option.getStrike();
+    double rate = option.getRate();
+    double carry = rate - option.getDividendYield();  // drift of the log-spot
+    double T = option.getTimeToMaturity();
+    
+    double a, b;
+    cosRange(model, carry, T, a, b);
+    double range = b - a;
+    
+    const std::complex<double> I(0.0, 1.0);
+    double x = std::log(spot / K);
+    double lower = x + a;
+    double upper = std::min(x + b, 0.0);
+    
+    double put = 0.0;
+    if (lower < 0.0) {
+        double sum = 0.0;
+        for (int k = 0; k < cosTerms_; ++k) {
+            double w = k * M_PI / range;
+            double cfTerm = (model.evaluate(w, carry, T) * std::exp(-I * w * a)).real();
+            sum += (k == 0 ? 0.5 : 1.0) * cfTerm * cosPutTerm(k, w, lower, upper);
+        }
+        put = std::exp(-rate * T) * 2.0 / range * K * sum;
+    }
+    
+    if (option.getOptionType() == OptionType::CALL) {
+        return std::max(put + spot * std::exp((carry - rate) * T) - K * std::exp(-rate * T), 0.0);
+    }
+    return std::max(put, 0.0);
+}
+
+void FourierEngine::priceChain(const OptionChain& chain, const PricingConfig& config,
+                               std::vector<double>& out) const {
+    if (!chain.isFinalized()) {
+        throw std::logic_error("OptionChain must be finalized before pricing");
+    }
+    
+    // Surface vols differ per strike, leaving no shared-vol runs to batch
+    if (config.volatilitySurface) {
+        PricingEngine::priceChain(chain, config, out);
+        return;
+    }
+    
+    out.assign(chain.size(), std::numeric_limits<double>::quiet_NaN());
+    const double* strikes = chain.strikes();
+    const double* vols = chain.volatilities();
+    const OptionType* types = chain.types();
+    const ExerciseType* exercises = chain.exercises();
+    const std::vector<OptionChain::ExpiryGroup>& groups = chain.getExpiryGroups();
+    
+    std::vector<size_t> legs;
+    std::vector<double> runStrikes;
+    for (auto group = groups.begin(); group != groups.end(); ++group) {
+        const OptionChain::Underlying& underlying = chain.getUnderlyings()[group->underlying];
+        
+        // Order the group's European legs so equal (vol, type) runs are contiguous
+        legs.clear();
+        for (size_t leg = group->begin; leg < group->end; ++leg) {
+            if (exercises[leg] == ExerciseType::EUROPEAN) {
+                legs.push_back(leg);
+            }
+        }
+        std::sort(legs.begin(), legs.end(), [vols, types](size_t a, size_t b) {
+            if (vols[a] != vols[b]) return vols[a] < vols[b];
+            return types[a] < types[b];
+        });
+        
+        size_t runStart = 0;
+        while (runStart < legs.size()) {
+            size_t runEnd = runStart;
+            runStrikes.clear();
+            while (runEnd < legs.size() && vols[legs[runEnd]] == vols[legs[runStart]] &&
+                   types[legs[runEnd]] == types[legs[runStart]]) {
+                runStrikes.push_back(strikes[legs[runEnd]]);
+                ++runEnd;
+            }
+            
+            BlackScholesModel model(vols[legs[runStart]]);
+            std::vector<double> prices = priceStrikes(model, underlying.spot - group->dividendPV, group->rate,
+                                                      group->timeToMaturity, runStrikes, types[legs[runStart]],
+                                                      group->dividendYield);
+            for (size_t i = runStart; i < runEnd; ++i) {
+                out[legs[i]] = prices[i - runStart];
+            }
+            runStart = runEnd;
+        }
+    }
+}
+
+std::vector<double> FourierEngine::priceStrikes(const CharacteristicFunction& model, double spot, double rate,
+                                                double timeToMaturity, const std::vector<double>& strikes,
+                                                OptionType type, double dividendYield) const {
+    double discount = std::exp(-rate * timeToMaturity);
+    double discountedSpot = spot * std::exp(-dividendYield * timeToMaturity);
+    std::vector<double> prices;
+
+    // Each method prices its numerically stable side; put-call parity gives the other
+    if (method_ == FourierMethod::CARR_MADAN_FFT) {
+        prices = carrMadanCalls(model, spot, rate, dividendYield, timeToMaturity, strikes);
+        if (type == OptionType::PUT) {
+            for (size_t i = 0; i < strikes.size(); ++i) {
+                prices[i] = prices[i] - discountedSpot + strikes[i] * discount;
+            }
+        }
+    } else {
+        prices = cosPuts(model, spot, rate, dividendYield, timeToMaturity, strikes);
+        if (type == OptionType::CALL) {
+            for (size_t i = 0; i < strikes.size(); ++i) {
+                prices[i] = prices[i] + discountedSpot - strikes[i] * discount;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < prices.size(); ++i) {
+        prices[i] = std::max(prices[i], 0.0);
+    }
+    return prices;
+}
+
+std::vector<double> FourierEngine::carrMadanCalls(const CharacteristicFunction& model, double spot, double rate,
+                                                  double dividendYield, double timeToMaturity,
+                                                  const std::vector<double>& strikes) const {
+    const std::complex<double> I(0.0, 1.0);
+    const double alpha = 1.5;
+    const double eta = 0.25;
+    const int N = fftPoints_;
+    const double lambda = 2.0 * M_PI / (N * eta);
+
+    // Log-strike grid centred on the spot: k_u = k0 + lambda * u
+    double logSpot = std::log(spot);
+    double k0 = logSpot - 0.5 * N * lambda;
+    double discount = std::exp(-rate * timeToMaturity);
+
+    std::vector<std::complex<double>> data(N);
+    for (int j = 0; j < N; ++j) {
+        double v = eta * j;
+        std::complex<double> u = v - (alpha + 1.0) * I;
+        std::complex<double> phi = std::exp(I * u * logSpot) *
+                                   model.evaluate(u, rate - dividendYield, timeToMaturity);
+        std::complex<double> psi = discount * phi /
+            (alpha * alpha + alpha - v * v + I * (2.0 * alpha + 1.0) * v);
+
+        // Simpson weights
+        double weight = (j == 0) ? 1.0 / 3.0 : ((j % 2 == 1) ? 4.0 / 3.0 : 2.0 / 3.0);
+        data[j] = std::exp(-I * v * k0) * psi * eta * weight;
+    }
+
+    fft(data);
+
+    std::vector<double> gridCalls(N);
+    for (int u = 0; u < N; ++u) {
+        double k = k0 + lambda * u;
+        gridCalls[u] = std::exp(-alpha * k) / M_PI * data[u].real();
+    }
+
+    // Cubic Lagrange interpolation in log-strike onto the requested strikes
+    std::vector<double> calls(strikes.size());
+    for (size_t s = 0; s < strikes.size(); ++s) {
+        double position = (std::log(strikes[s]) - k0) / lambda;
+        int base = static_cast<int>(std::floor(position)) - 1;
+        if (base < 0 || base + 3 >= N) {
+            throw std::invalid_argument("Strike outside the FFT log-strike grid");
+        }
+
+        double t = position - (base + 1);
+        double p0 = gridCalls[base], p1 = gridCalls[base + 1];
+        double p2 = gridCalls[base + 2], p3 = gridCalls[base + 3];
+        calls[s] = -t * (t - 1.0) * (t - 2.0) / 6.0 * p0 +
+                   (t + 1.0) * (t - 1.0) * (t - 2.0) / 2.0 * p1 -
+                   (t + 1.0) * t * (t - 2.0) / 2.0 * p2 +
+                   (t + 1.0) * t * (t - 1.0) / 6.0 * p3;
+    }
+
+    return calls;
+}
+
+std::vector<double> FourierEngine::cosPuts(const CharacteristicFunction& model, double spot, double rate,
+                                           double dividendYield, double timeToMaturity,
+                                           const std::vector<double>& strikes) const {
+    const std::complex<double> I(0.0, 1.0);
+    const int N = cosTerms_;
+    double carry = rate - dividendYield;
+
+    double a, b;
+    cosRange(model, carry, timeToMaturity, a, b);
+    double range = b - a;
+    double discount = std::exp(-rate * timeToMaturity);
+
+    // The characteristic function terms do not depend on the strike, so they are
+    // evaluated once and shared across the whole strike vector.
+    std::vector<double> frequencies(N);
+    std::vector<double> cfTerms(N);
+    for (int k = 0; k < N; ++k) {
+        frequencies[k] = k * M_PI / range;
+        cfTerms[k] = (model.evaluate(frequencies[k], carry, timeToMaturity) *
+                      std::exp(-I * frequencies[k] * a)).real();
+    }
+    cfTerms[0] *= 0.5;
+
+    std::vector<double> puts(strikes.size());
+    for (size_t s = 0; s < strikes.size(); ++s) {
+        double K = strikes[s];
+        double x = std::log(spot / K);
+
+        // Put payoff K(1 - e^y)^+ on y = ln(S_T / K) in [lower, upper]
+        double lower = x + a;
+        double upper = std::min(x + b, 0.0);
+        if (lower >= 0.0) {
+            puts[s] = 0.0;
+            continue;
+        }
+
+        double sum = 0.0;
+        for (int k = 0; k < N; ++k) {
+            sum += cfTerms[k] * cosPutTerm(k, frequencies[k], lower, upper);
+        }
+
+        puts[s] = discount * 2.0 / range * K * sum;
+    }
+
+    return puts;
+}
+
+void FourierEngine::cosRange(const CharacteristicFunction& model, double rate, double timeToMaturity,
+                             double& a, double& b) {
+    const double L = 10.0;
+    CharacteristicFunction::Cumulants c = model.cumulants(rate, timeToMaturity);
+    double width = L * std::sqrt(c.c2 + std::sqrt(c.c4));
+    a = c.c1 - width;
+    b = c.c1 + width;
+}
+
+double FourierEngine::cosPutTerm(int k, double w, double lower, double upper) {
+    // psi_k - chi_k on [lower, upper], with the expansion interval starting at lower
+    double arg = w * (upper - lower);
+    double cosArg = std::cos(arg);
+    double sinArg = std::sin(arg);
+    double expUpper = std::exp(upper);
+
+    double chi = (cosArg * expUpper - std::exp(lower) + w * sinArg * expUpper) / (1.0 + w * w);
+    double psi = (k == 0) ? (upper - lower) : sinArg / w;
+    return psi - chi;
+}
+
+void FourierEngine::fft(std::vector<std::complex<double>>& data) {
+    const size_t n = data.size();
+    if ((n & (n - 1)) != 0) {
+        throw std::invalid_argument("FFT size must be a power of two");
+    }
+
+    // Bit-reversal permutation
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(data[i], data[j]);
+        }
+    }
+
+    // Iterative Cooley-Tukey butterflies, forward transform exp(-2*pi*i*jk/n)
+    for (size_t length = 2; length <= n; length <<= 1) {
+        double angle = -2.0 * M_PI / length;
+        std::complex<double> root(std::cos(angle), std::sin(angle));
+        for (size_t start = 0; start < n; start += length) {
+            std::complex<double> w(1.0, 0.0);
+            for (size_t k = 0; k < length / 2; ++k) {
+                std::complex<double> even = data[start + k];
+                std::complex<double> odd = w * data[start + k + length / 2];
+                data[start + k] = even + odd;
+                data[start + k + length / 2] = even - odd;
+                w *= root;
+            }
+        }
+    }
+}
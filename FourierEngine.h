@@ -0,0 +1,51 @@
+// FourierEngine.h
+#ifndef FOURIER_ENGINE_H
+#define FOURIER_ENGINE_H
+
+#include "PricingEngine.h"
+#include "CharacteristicFunction.h"
+#include <complex>
+#include <vector>
+
+enum class FourierMethod { CARR_MADAN_FFT, COS };
+
+// Prices European options on a whole strike vector from a model's characteristic
+// function: Carr-Madan FFT in O(N log N) or Fang-Oosterlee COS in O(N*K).
+class FourierEngine : public PricingEngine {
+public:
+    FourierEngine(FourierMethod method = FourierMethod::COS, int fftPoints = 4096, int cosTerms = 256)
+        : method_(method), fftPoints_(fftPoints), cosTerms_(cosTerms) {}
+
+    // Single option under Black-Scholes dynamics with the option's own (or the
+    // config surface's) volatility, always via COS since there is no strike grid to amortize an FFT over
+    using PricingEngine::price;
+    double price(const Option& option, const PricingConfig& config) const override;
+    std::string getMethodName() const override { return "Fourier"; }
+    
+    // One strike-vector pass per (expiry group, volatility, option type)
+    void priceChain(const OptionChain& chain, const PricingConfig& config, std::vector<double>& out) const override;
+
+    // The model's characteristic function is evaluated with drift rate - dividendYield
+    std::vector<double> priceStrikes(const CharacteristicFunction& model, double spot, double rate,
+                                     double timeToMaturity, const std::vector<double>& strikes,
+                                     OptionType type, double dividendYield = 0.0) const;
+
+private:
+    FourierMethod method_;
+    int fftPoints_;
+    int cosTerms_;
+
+    std::vector<double> carrMadanCalls(const CharacteristicFunction& model, double spot, double rate,
+                                       double dividendYield, double timeToMaturity,
+                                       const std::vector<double>& strikes) const;
+    std::vector<double> cosPuts(const CharacteristicFunction& model, double spot, double rate,
+                                double dividendYield, double timeToMaturity,
+                                const std::vector<double>& strikes) const;
+
+    static void cosRange(const CharacteristicFunction& model, double rate, double timeToMaturity,
+                         double& a, double& b);
+    static double cosPutTerm(int k, double w, double lower, double upper);
+    static void fft(std::vector<std::complex<double>>& data);
+};
+
+#endif
@@ -0,0 +1,196 @@
+#include "IncrementalRiskEngine.h"
+#include <algorithm>
+#include <stdexcept>
+
+IncrementalRiskEngine::IncrementalRiskEngine(const OptionChain& book, const ExpiryBuckets& buckets,
+                                             ThreadPool& pool)
+    : book_(book), buckets_(buckets), pool_(pool), repricedLegs_(0), flushesSinceResum_(0) {
+    if (!book.isFinalized()) {
+        throw std::logic_error("OptionChain must be finalized before risk can be tracked");
+    }
+    
+    const std::vector<OptionChain::Underlying>& underlyings = book.getUnderlyings();
+    const std::vector<OptionChain::ExpiryGroup>& groups = book.getExpiryGroups();
+    
+    spots_.resize(underlyings.size());
+    for (size_t u = 0; u < underlyings.size(); ++u) {
+        spots_[u] = underlyings[u].spot;
+    }
+    
+    rates_.resize(groups.size());
+    volShifts_.assign(groups.size(), 0.0);
+    groupsByUnderlying_.resize(underlyings.size());
+    groupBuckets_.resize(groups.size());
+    for (size_t g = 0; g < groups.size(); ++g) {
+        rates_[g] = groups[g].rate;
+        groupsByUnderlying_[groups[g].underlying].push_back(g);
+        groupBuckets_[g] = buckets_.bucketFor(groups[g].timeToMaturity);
+    }
+    
+    groupRisk_.resize(groups.size());
+    dirty_.assign(groups.size(), 0);
+    risk_.numBuckets = buckets_.size();
+    risk_.byUnderlying.resize(underlyings.size());
+    risk_.byExpiryBucket.resize(risk_.numBuckets);
+    risk_.byUnderlyingAndBucket.resize(underlyings.size() * risk_.numBuckets);
+    
+    // Initial valuation is just a flush with every group dirty
+    for (size_t g = 0; g < groups.size(); ++g) {
+        markDirty(g);
+    }
+    flush();
+}
+
+void IncrementalRiskEngine::setSpot(size_t underlying, double spot) {
+    if (spot <= 0.0) {
+        throw std::invalid_argument("Spot price must be positive");
+    }
+    if (spots_.at(underlying) == spot) {
+        return;
+    }
+    spots_[underlying] = spot;
+    const std::vector<size_t>& dependents = groupsByUnderlying_[underlying];
+    for (auto it = dependents.begin(); it != dependents.end(); ++it) {
+        markDirty(*it);
+    }
+}
+
+void IncrementalRiskEngine::setRate(size_t group, double rate) {
+    if (rates_.at(group) == rate) {
+        return;
+    }
+    rates_[group] = rate;
+    markDirty(group);
+}
+
+void IncrementalRiskEngine::setVolShift(size_t group, double shift) {
+    if (volShifts_.at(group) == shift) {
+        return;
+    }
+    volShifts_[group] = shift;
+    markDirty(group);
+}
+
+void IncrementalRiskEngine::setUnderlyingVolShift(size_t underlying, double shift) {
+    const std::vector<size_t>& dependents = groupsByUnderlying_.at(underlying);
+    for (auto it = dependents.begin(); it != dependents.end(); ++it) {
+        setVolShift(*it, shift);
+    }
+}
+
+void IncrementalRiskEngine::markDirty(size_t group) {
+    if (!dirty_[group]) {
+        dirty_[group] = 1;
+        dirtyGroups_.push_back(group);
+    }
+}
+
+void IncrementalRiskEngine::flush() {
+    if (dirtyGroups_.empty()) {
+        return;
+    }
+    
+    const std::vector<OptionChain::ExpiryGroup>& groups = book_.getExpiryGroups();
+    
+    // Same chunking as a full aggregation, restricted to the dirty groups
+    struct Chunk {
+        size_t group, begin, end;
+    };
+    std::vector<Chunk> chunks;
+    size_t dirtyLegs = 0;
+    for (auto it = dirtyGroups_.begin(); it != dirtyGroups_.end(); ++it) {
+        const OptionChain::ExpiryGroup& group = groups[*it];
+        dirtyLegs += group.end - group.begin;
+        for (size_t begin = group.begin; begin < group.end; begin += CHUNK_SIZE) {
+            Chunk chunk = { *it, begin, std::min(group.end, begin + CHUNK_SIZE) };
+            chunks.push_back(chunk);
+        }
+    }
+    
+    std::vector<RiskTotals> partials(chunks.size());
+    auto reprice = [this, &chunks, &partials](size_t first, size_t last) {
+        for (size_t c = first; c < last; ++c) {
+            const Chunk& chunk = chunks[c];
+            size_t u = book_.getExpiryGroups()[chunk.group].underlying;
+            double value = 0.0;
+            Greeks greeks = Greeks();
+            blackScholesEngine_.accumulateGreeks(book_, chunk.group, chunk.begin, chunk.end,
+                                                 spots_[u], rates_[chunk.group], volShifts_[chunk.group],
+                                                 value, greeks);
+            partials[c].value = value;
+            partials[c].delta = greeks.delta;
+            partials[c].gamma = greeks.gamma;
+            partials[c].vega = greeks.vega;
+            partials[c].theta = greeks.theta;
+        }
+    };
+    
+    if (dirtyLegs < PARALLEL_THRESHOLD) {
+        reprice(0, chunks.size());
+    } else {
+        pool_.parallelFor(chunks.size(), 1, reprice);
+    }
+    repricedLegs_ += dirtyLegs;
+    
+    // Group totals are rebuilt from the fresh partials on every flush; aggregates
+    // are patched by the change, or re-summed from scratch once in a while
+    bool resum = ++flushesSinceResum_ >= RESUM_INTERVAL || 2 * dirtyGroups_.size() >= groups.size();
+    for (auto it = dirtyGroups_.begin(); it != dirtyGroups_.end(); ++it) {
+        size_t g = *it;
+        if (!resum) {
+            size_t u = groups[g].underlying;
+            size_t cell = u * risk_.numBuckets + groupBuckets_[g];
+            risk_.total -= groupRisk_[g];
+            risk_.byUnderlying[u] -= groupRisk_[g];
+            risk_.byExpiryBucket[groupBuckets_[g]] -= groupRisk_[g];
+            risk_.byUnderlyingAndBucket[cell] -= groupRisk_[g];
+        }
+        groupRisk_[g] = RiskTotals();
+        dirty_[g] = 0;
+    }
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        size_t g = chunks[c].group;
+        groupRisk_[g] += partials[c];
+        if (!resum) {
+            size_t u = groups[g].underlying;
+            size_t cell = u * risk_.numBuckets + groupBuckets_[g];
+            risk_.total += partials[c];
+            risk_.byUnderlying[u] += partials[c];
+            risk_.byExpiryBucket[groupBuckets_[g]] += partials[c];
+            risk_.byUnderlyingAndBucket[cell] += partials[c];
+        }
+    }
+    dirtyGroups_.clear();
+    
+    if (resum) {
+        resumAggregates();
+    }
+}
+
+void IncrementalRiskEngine::resumAggregates() {
+    const std::vector<OptionChain::ExpiryGroup>& groups = book_.getExpiryGroups();
+    
+    risk_.total = RiskTotals();
+    std::fill(risk_.byUnderlying.begin(), risk_.byUnderlying.end(), RiskTotals());
+    std::fill(risk_.byExpiryBucket.begin(), risk_.byExpiryBucket.end(), RiskTotals());
+    std::fill(risk_.byUnderlyingAndBucket.begin(), risk_.byUnderlyingAndBucket.end(), RiskTotals());
+    for (size_t g = 0; g < groups.size(); ++g) {
+        size_t u = groups[g].underlying;
+        size_t cell = u * risk_.numBuckets + groupBuckets_[g];
+        risk_.total += groupRisk_[g];
+        risk_.byUnderlying[u] += groupRisk_[g];
+        risk_.byExpiryBucket[groupBuckets_[g]] += groupRisk_[g];
+        risk_.byUnderlyingAndBucket[cell] += groupRisk_[g];
+    }
+    flushesSinceResum_ = 0;
+}
+
+const PortfolioRisk& IncrementalRiskEngine::getRisk() {
+    flush();
+    return risk_;
+}
+
+const RiskTotals& IncrementalRiskEngine::getGroupRisk(size_t group) {
+    flush();
+    return groupRisk_.at(group);
+}
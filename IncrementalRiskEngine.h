@@ -0,0 +1,66 @@
+// IncrementalRiskEngine.h
+#ifndef INCREMENTAL_RISK_ENGINE_H
+#define INCREMENTAL_RISK_ENGINE_H
+
+#include "PortfolioRiskEngine.h"
+#include <vector>
+
+// Keeps book risk live under market ticks. Market inputs are nodes of a small
+// dependency graph: each underlying's spot feeds all of its expiry groups, and
+// each expiry group has its own rate and additive vol shift. A tick only marks
+// the dependent groups dirty; flush() reprices just those groups and patches the
+// aggregates by the change in each group's cached totals, so the cost of a tick
+// follows the number of legs it touches rather than the size of the book. Every
+// RESUM_INTERVAL flushes, or when most groups are dirty anyway, the aggregates
+// are instead re-summed from the group totals so patching rounding cannot drift.
+class IncrementalRiskEngine {
+public:
+    // The book must be finalized and outlive the engine
+    IncrementalRiskEngine(const OptionChain& book, const ExpiryBuckets& buckets = ExpiryBuckets(),
+                          ThreadPool& pool = ThreadPool::shared());
+    
+    void setSpot(size_t underlying, double spot);
+    void setRate(size_t group, double rate);
+    void setVolShift(size_t group, double shift);
+    void setUnderlyingVolShift(size_t underlying, double shift);
+    
+    // Reprices dirty groups in one batch; getRisk() flushes first
+    void flush();
+    const PortfolioRisk& getRisk();
+    
+    const RiskTotals& getGroupRisk(size_t group);
+    size_t getDirtyGroupCount() const { return dirtyGroups_.size(); }
+    size_t getRepricedLegCount() const { return repricedLegs_; }
+
+private:
+    const OptionChain& book_;
+    ExpiryBuckets buckets_;
+    BlackScholesEngine blackScholesEngine_;
+    ThreadPool& pool_;
+    
+    // Market nodes
+    std::vector<double> spots_;       // per underlying
+    std::vector<double> rates_;       // per expiry group
+    std::vector<double> volShifts_;   // per expiry group
+    
+    // Edges from underlyings to their expiry groups
+    std::vector<std::vector<size_t>> groupsByUnderlying_;
+    std::vector<size_t> groupBuckets_;
+    
+    std::vector<RiskTotals> groupRisk_;
+    std::vector<char> dirty_;
+    std::vector<size_t> dirtyGroups_;
+    PortfolioRisk risk_;
+    size_t repricedLegs_;
+    size_t flushesSinceResum_;
+    
+    void markDirty(size_t group);
+    void resumAggregates();
+    
+    // Below this many dirty legs a flush runs on the calling thread
+    static const size_t PARALLEL_THRESHOLD = 16384;
+    static const size_t CHUNK_SIZE = 16384;
+    static const size_t RESUM_INTERVAL = 1024;
+};
+
+#endif
@@ -0,0 +1,319 @@
+#include "LocalVolatilityEngine.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+const double MIN_LOCAL_VARIANCE = 1e-4;
+const double MAX_LOCAL_VARIANCE = 4.0;
+
+// Gatheral's form of Dupire in total variance:
+// sigma^2 = w_T / (1 - k w_k / w + (-1/4 - 1/w + k^2/w^2) w_k^2 / 4 + w_kk / 2)
+double dupireVariance(const VolatilitySurface::Slice& slice, const VolatilitySurface::Slice& before,
+                      const VolatilitySurface::Slice& after, double timeStep, double k) {
+    const double h = 1e-3;
+    double w = slice.totalVariance(k);
+    double wUp = slice.totalVariance(k + h);
+    double wDown = slice.totalVariance(k - h);
+    double wk = (wUp - wDown) / (2.0 * h);
+    double wkk = (wUp - 2.0 * w + wDown) / (h * h);
+    double wT = (after.totalVariance(k) - before.totalVariance(k)) / (2.0 * timeStep);
+    
+    if (w <= 0.0 || wT <= 0.0) {
+        return MIN_LOCAL_VARIANCE;
+    }
+    double denominator = 1.0 - k * wk / w + 0.25 * (-0.25 - 1.0 / w + k * k / (w * w)) * wk * wk + 0.5 * wkk;
+    if (denominator <= 0.0) {
+        return MAX_LOCAL_VARIANCE;
+    }
+    return std::min(std::max(wT / denominator, MIN_LOCAL_VARIANCE), MAX_LOCAL_VARIANCE);
+}
+
+double timeStepFor(double time) {
+    return std::min(1e-3, 0.5 * time);
+}
+
+}
+
+LocalVolatilityGrid::LocalVolatilityGrid(std::shared_ptr<const VolatilitySurface> surface, double flatVolatility,
+                                         double spot, double rate, double dividendYield, double maturity,
+                                         double lowerSpot, double upperSpot, const Settings& settings)
+    : surface_(surface), spot_(spot), rate_(rate), dividendYield_(dividendYield), maturity_(maturity) {
+    if (settings.spotSteps < 3 || settings.timeSteps < 1) {
+        throw std::invalid_argument("Local volatility grid needs at least 3 spot steps and 1 time step");
+    }
+    if (maturity <= 0.0 || spot <= 0.0) {
+        throw std::invalid_argument("Local volatility grid needs a positive spot and maturity");
+    }
+    if (!(lowerSpot > 0.0 && lowerSpot < spot && spot < upperSpot)) {
+        throw std::invalid_argument("Local volatility grid domain must bracket the spot");
+    }
+    
+    const int M = settings.spotSteps;
+    const int N = settings.timeSteps;
+    logLower_ = std::log(lowerSpot);
+    logStep_ = (std::log(upperSpot) - logLower_) / M;
+    spots_.resize(M + 1);
+    for (int i = 0; i <= M; ++i) {
+        spots_[i] = std::exp(logLower_ + i * logStep_);
+    }
+    
+    const double dt = maturity / N;
+    const double h = logStep_;
+    const double logSpot = std::log(spot);
+    const size_t interior = M - 1;
+    std::vector<double> variance(interior, flatVolatility * flatVolatility);
+    
+    steps_.resize(N);
+    for (int n = 0; n < N; ++n) {
+        StepOperator& step = steps_[n];
+        step.theta = (n < settings.rannacherSteps) ? 1.0 : 0.5;
+        
+        // Coefficients frozen at the step's midpoint in calendar time
+        double time = maturity - (n + 0.5) * dt;
+        if (surface) {
+            double timeStep = timeStepFor(time);
+            VolatilitySurface::Slice slice = surface->sliceAt(time);
+            VolatilitySurface::Slice before = surface->sliceAt(time - timeStep);
+            VolatilitySurface::Slice after = surface->sliceAt(time + timeStep);
+            double forwardShift = logSpot + (rate - dividendYield) * time;
+            for (size_t k = 0; k < interior; ++k) {
+                double x = logLower_ + (k + 1) * h;
+                variance[k] = dupireVariance(slice, before, after, timeStep, x - forwardShift);
+            }
+        }
+        
+        step.lower.resize(interior);
+        step.diagonal.resize(interior);
+        step.upper.resize(interior);
+        step.upperFactor.resize(interior);
+        step.pivot.resize(interior);
+        for (size_t k = 0; k < interior; ++k) {
+            double diffusion = 0.5 * variance[k] / (h * h);
+            double drift = (rate - dividendYield - 0.5 * variance[k]) / (2.0 * h);
+            step.lower[k] = dt * (diffusion - drift);
+            step.diagonal[k] = dt * (-2.0 * diffusion - rate);
+            step.upper[k] = dt * (diffusion + drift);
+        }
+        
+        // Thomas factorization of I - theta * L, reused by every rollback
+        double theta = step.theta;
+        for (size_t k = 0; k < interior; ++k) {
+            double elimination = (k == 0) ? 0.0 : -theta * step.lower[k] * step.upperFactor[k - 1];
+            step.pivot[k] = 1.0 / (1.0 - theta * step.diagonal[k] - elimination);
+            step.upperFactor[k] = -theta * step.upper[k] * step.pivot[k];
+        }
+    }
+}
+
+double LocalVolatilityGrid::rollback(std::vector<double> values, const BoundaryValue& lower,
+                                     const BoundaryValue& upper, const std::vector<double>* exerciseValues) const {
+    const size_t M = spots_.size() - 1;
+    if (values.size() != spots_.size() || (exerciseValues && exerciseValues->size() != spots_.size())) {
+        throw std::invalid_argument("Grid values must have one entry per grid spot");
+    }
+    
+    const size_t interior = M - 1;
+    const double dt = maturity_ / steps_.size();
+    thread_local std::vector<double> rhs;
+    rhs.resize(interior);
+    
+    for (size_t n = 0; n < steps_.size(); ++n) {
+        const StepOperator& step = steps_[n];
+        double theta = step.theta;
+        double explicitWeight = 1.0 - theta;
+        double remaining = (n + 1) * dt;
+        double lowerValue = lower(remaining);
+        double upperValue = upper(remaining);
+        
+        for (size_t k = 0; k < interior; ++k) {
+            size_t i = k + 1;
+            rhs[k] = values[i] + explicitWeight * (step.lower[k] * values[i - 1] + step.diagonal[k] * values[i] +
+                                                   step.upper[k] * values[i + 1]);
+        }
+        rhs[0] += theta * step.lower[0] * lowerValue;
+        rhs[interior - 1] += theta * step.upper[interior - 1] * upperValue;
+        
+        rhs[0] *= step.pivot[0];
+        for (size_t k = 1; k < interior; ++k) {
+            rhs[k] = (rhs[k] + theta * step.lower[k] * rhs[k - 1]) * step.pivot[k];
+        }
+        values[interior] = rhs[interior - 1];
+        for (size_t k = interior - 1; k-- > 0;) {
+            values[k + 1] = rhs[k] - step.upperFactor[k] * values[k + 2];
+        }
+        values[0] = lowerValue;
+        values[M] = upperValue;
+        
+        if (exerciseValues) {
+            for (size_t i = 1; i < M; ++i) {
+                values[i] = std::max(values[i], (*exerciseValues)[i]);
+            }
+        }
+    }
+    
+    // Quadratic interpolation around the node nearest the spot
+    double position = (std::log(spot_) - logLower_) / logStep_;
+    size_t j = static_cast<size_t>(std::min(std::max(std::floor(position + 0.5), 1.0), static_cast<double>(M - 1)));
+    double u = position - j;
+    return values[j - 1] * 0.5 * u * (u - 1.0) + values[j] * (1.0 - u * u) + values[j + 1] * 0.5 * u * (u + 1.0);
+}
+
+double LocalVolatilityGrid::localVariance(const VolatilitySurface& surface, double logMoneyness, double time) {
+    double timeStep = timeStepFor(time);
+    return dupireVariance(surface.sliceAt(time), surface.sliceAt(time - timeStep),
+                          surface.sliceAt(time + timeStep), timeStep, logMoneyness);
+}
+
+Option LocalVolatilityEngine::resolveCarry(const Option& option, const PricingConfig& config) const {
+    // The surface is used whole through local vol, so only the term structure is resolved here
+    PricingConfig carryConfig = config;
+    carryConfig.volatilitySurface.reset();
+    return resolveMarketData(option, carryConfig);
+}
+
+void LocalVolatilityEngine::defaultDomain(const Option& option, const PricingConfig& config,
+                                          double& lowerSpot, double& upperSpot) const {
+    double T = option.getTimeToMaturity();
+    double referenceVol = config.volatilitySurface ? config.volatilitySurface->volatility(0.0, T)
+                                                   : option.getVolatility();
+    double width = std::max(5.0 * referenceVol * std::sqrt(T), 0.25);
+    
+    double logSpot = std::log(option.getSpot());
+    double logForward = logSpot + (option.getRate() - option.getDividendYield()) * T;
+    double logStrike = std::log(option.getStrike());
+    double lower = std::min(std::min(logSpot, logForward) - width, logStrike - 0.5 * width);
+    double upper = std::max(std::max(logSpot, logForward) + width, logStrike + 0.5 * width);
+    lowerSpot = std::exp(lower);
+    upperSpot = std::exp(upper);
+}
+
+std::shared_ptr<const LocalVolatilityGrid> LocalVolatilityEngine::gridFor(const Option& option,
+                                                                          const PricingConfig& config,
+                                                                          double lowerSpot, double upperSpot) const {
+    const VolatilitySurface* surface = config.volatilitySurface.get();
+    GridKey key(surface, surface ? 0.0 : option.getVolatility(), option.getSpot(), option.getRate(),
+                option.getDividendYield(), option.getTimeToMaturity(), lowerSpot, upperSpot);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = grids_.find(key);
+        if (it != grids_.end()) {
+            return it->second;
+        }
+    }
+    
+    // Built outside the lock; a racing build of the same key keeps whichever lands first
+    auto grid = std::make_shared<const LocalVolatilityGrid>(
+        config.volatilitySurface, option.getVolatility(), option.getSpot(), option.getRate(),
+        option.getDividendYield(), option.getTimeToMaturity(), lowerSpot, upperSpot, settings_);
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (grids_.size() >= maxCachedGrids_) {
+        grids_.clear();
+    }
+    auto inserted = grids_.emplace(key, grid);
+    if (inserted.second) {
+        ++gridBuilds_;
+    }
+    return inserted.first->second;
+}
+
+double LocalVolatilityEngine::solve(const LocalVolatilityGrid& grid, const Option& option,
+                                    const LocalVolatilityGrid::BoundaryValue& lower,
+                                    const LocalVolatilityGrid::BoundaryValue& upper) const {
+    const std::vector<double>& spots = grid.spots();
+    std::vector<double> intrinsic(spots.size());
+    for (size_t i = 0; i < spots.size(); ++i) {
+        intrinsic[i] = option.payoff(spots[i]);
+    }
+    bool american = option.getExerciseType() == ExerciseType::AMERICAN;
+    
+    std::vector<double> terminal = intrinsic;
+    terminal.front() = lower(0.0);
+    terminal.back() = upper(0.0);
+    return grid.rollback(terminal, lower, upper, american ? &intrinsic : nullptr);
+}
+
+double LocalVolatilityEngine::price(const Option& quoted, const PricingConfig& config) const {
+    const Option option = resolveCarry(quoted, config);
+    double lowerSpot, upperSpot;
+    defaultDomain(option, config, lowerSpot, upperSpot);
+    std::shared_ptr<const LocalVolatilityGrid> grid = gridFor(option, config, lowerSpot, upperSpot);
+    
+    double K = option.getStrike();
+    double r = option.getRate();
+    double q = option.getDividendYield();
+    bool american = option.getExerciseType() == ExerciseType::AMERICAN;
+    bool call = option.getOptionType() == OptionType::CALL;
+    
+    // Far-field values: the option is either worthless or a forward, or exercised at once
+    auto lower = [=](double tau) {
+        if (call) return 0.0;
+        double forward = K * std::exp(-r * tau) - lowerSpot * std::exp(-q * tau);
+        return american ? std::max(forward, K - lowerSpot) : forward;
+    };
+    auto upper = [=](double tau) {
+        if (!call) return 0.0;
+        double forward = upperSpot * std::exp(-q * tau) - K * std::exp(-r * tau);
+        return american ? std::max(forward, upperSpot - K) : forward;
+    };
+    return solve(*grid, option, lower, upper);
+}
+
+double LocalVolatilityEngine::priceBarrier(const Option& quoted, const Barrier& barrier,
+                                           const PricingConfig& config) const {
+    if (barrier.level <= 0.0 || barrier.rebate < 0.0) {
+        throw std::invalid_argument("Barrier level must be positive and rebate non-negative");
+    }
+    
+    const Option option = resolveCarry(quoted, config);
+    bool up = barrier.type == BarrierType::UP_AND_OUT;
+    if (up ? option.getSpot() >= barrier.level : option.getSpot() <= barrier.level) {
+        return barrier.rebate;
+    }
+    
+    // The barrier becomes a grid boundary, so barriers at the same level share a grid
+    double lowerSpot, upperSpot;
+    defaultDomain(option, config, lowerSpot, upperSpot);
+    if (up) {
+        upperSpot = barrier.level;
+    } else {
+        lowerSpot = barrier.level;
+    }
+    std::shared_ptr<const LocalVolatilityGrid> grid = gridFor(option, config, lowerSpot, upperSpot);
+    
+    double K = option.getStrike();
+    double r = option.getRate();
+    double q = option.getDividendYield();
+    double rebate = barrier.rebate;
+    bool american = option.getExerciseType() == ExerciseType::AMERICAN;
+    bool call = option.getOptionType() == OptionType::CALL;
+    
+    LocalVolatilityGrid::BoundaryValue knockedOut = [rebate](double) { return rebate; };
+    LocalVolatilityGrid::BoundaryValue farField;
+    if (up) {
+        farField = [=](double tau) {
+            if (call) return 0.0;
+            double forward = K * std::exp(-r * tau) - lowerSpot * std::exp(-q * tau);
+            return american ? std::max(forward, K - lowerSpot) : forward;
+        };
+        return solve(*grid, option, farField, knockedOut);
+    }
+    farField = [=](double tau) {
+        if (!call) return 0.0;
+        double forward = upperSpot * std::exp(-q * tau) - K * std::exp(-r * tau);
+        return american ? std::max(forward, upperSpot - K) : forward;
+    };
+    return solve(*grid, option, knockedOut, farField);
+}
+
+size_t LocalVolatilityEngine::getGridBuildCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return gridBuilds_;
+}
+
+void LocalVolatilityEngine::clearGrids() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    grids_.clear();
+}
@@ -0,0 +1,112 @@
+// LocalVolatilityEngine.h
+#ifndef LOCAL_VOLATILITY_ENGINE_H
+#define LOCAL_VOLATILITY_ENGINE_H
+
+#include "PricingEngine.h"
+#include "VolatilitySurface.h"
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+enum class BarrierType { UP_AND_OUT, DOWN_AND_OUT };
+
+// Continuously monitored knock-out barrier; the rebate is paid when it is hit
+struct Barrier {
+    BarrierType type;
+    double level;
+    double rebate;
+};
+
+// Theta-scheme finite differences in log-spot under Dupire local volatility, for
+// one underlying, maturity and spot domain. Every time step's operator and its
+// tridiagonal LU factors are built once in the constructor, so each rollback is
+// one explicit sweep and one forward/back substitution per step.
+class LocalVolatilityGrid {
+public:
+    struct Settings {
+        int spotSteps = 400;
+        int timeSteps = 200;
+        int rannacherSteps = 2;  // fully implicit steps at maturity to damp payoff kinks
+    };
+    
+    // Boundary value as a function of the time remaining to maturity
+    typedef std::function<double(double)> BoundaryValue;
+    
+    // Without a surface the local volatility is flatVolatility everywhere
+    LocalVolatilityGrid(std::shared_ptr<const VolatilitySurface> surface, double flatVolatility,
+                        double spot, double rate, double dividendYield, double maturity,
+                        double lowerSpot, double upperSpot, const Settings& settings);
+    
+    // Rolls values at spots() from maturity back to today and interpolates at the
+    // spot. Boundary nodes are set from lower/upper each step; when exerciseValues
+    // is given, interior values are floored at it after every step.
+    double rollback(std::vector<double> values, const BoundaryValue& lower, const BoundaryValue& upper,
+                    const std::vector<double>* exerciseValues = nullptr) const;
+    
+    const std::vector<double>& spots() const { return spots_; }
+    double getMaturity() const { return maturity_; }
+    double getRate() const { return rate_; }
+    double getDividendYield() const { return dividendYield_; }
+    
+    // Dupire local variance from the surface's total variance w(k, T) at
+    // log-forward-moneyness k, clamped where the surface admits arbitrage
+    static double localVariance(const VolatilitySurface& surface, double logMoneyness, double time);
+
+private:
+    // L V_i = a_i V_{i-1} + b_i V_i + c_i V_{i+1} over interior nodes, scaled by
+    // the step; the implicit part's factors are upperFactor and pivot
+    struct StepOperator {
+        double theta;
+        std::vector<double> lower, diagonal, upper;
+        std::vector<double> upperFactor, pivot;
+    };
+    
+    std::shared_ptr<const VolatilitySurface> surface_;  // kept alive while the grid is cached
+    double spot_, rate_, dividendYield_, maturity_;
+    double logLower_, logStep_;
+    std::vector<double> spots_;
+    std::vector<StepOperator> steps_;  // steps_[n] advances time remaining from n*dt to (n+1)*dt
+};
+
+// Local-volatility prices for European, American and knock-out options that are
+// consistent with the config's implied volatility surface. Grids are cached per
+// (surface, spot, carry, maturity, domain), so further payoffs on the same
+// underlying and maturity reuse the factorized operators. Term structures are
+// applied as flat rates and yields to each option's maturity.
+class LocalVolatilityEngine : public PricingEngine {
+public:
+    explicit LocalVolatilityEngine(const LocalVolatilityGrid::Settings& settings = LocalVolatilityGrid::Settings(),
+                                   size_t maxCachedGrids = 64)
+        : settings_(settings), maxCachedGrids_(maxCachedGrids), gridBuilds_(0) {}
+    
+    using PricingEngine::price;
+    double price(const Option& option, const PricingConfig& config) const override;
+    std::string getMethodName() const override { return "LocalVolatility"; }
+    
+    double priceBarrier(const Option& option, const Barrier& barrier, const PricingConfig& config) const;
+    
+    size_t getGridBuildCount() const;
+    void clearGrids();
+
+private:
+    typedef std::tuple<const VolatilitySurface*, double, double, double, double, double, double, double> GridKey;
+    
+    LocalVolatilityGrid::Settings settings_;
+    size_t maxCachedGrids_;
+    mutable std::mutex mutex_;
+    mutable std::map<GridKey, std::shared_ptr<const LocalVolatilityGrid>> grids_;
+    mutable size_t gridBuilds_;
+    
+    Option resolveCarry(const Option& option, const PricingConfig& config) const;
+    std::shared_ptr<const LocalVolatilityGrid> gridFor(const Option& option, const PricingConfig& config,
+                                                       double lowerSpot, double upperSpot) const;
+    void defaultDomain(const Option& option, const PricingConfig& config, double& lowerSpot, double& upperSpot) const;
+    double solve(const LocalVolatilityGrid& grid, const Option& option,
+                 const LocalVolatilityGrid::BoundaryValue& lower,
+                 const LocalVolatilityGrid::BoundaryValue& upper) const;
+};
+
+#endif
@@ -0,0 +1,190 @@
+#include "MarketDataStore.h"
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+
+const size_t MarketSnapshot::npos;
+
+size_t MarketSnapshot::find(const std::string& name) const {
+    auto it = names_->index.find(name);
+    return it == names_->index.end() ? npos : it->second;
+}
+
+Option MarketSnapshot::makeOption(const OptionContract& contract) const {
+    if (contract.instrument >= quotes_.size()) {
+        throw std::out_of_range("Unknown instrument in option contract");
+    }
+    const MarketQuote& market = quotes_[contract.instrument];
+    return Option(market.spot, contract.strike, market.rate, market.volatility,
+                  contract.timeToMaturity, contract.type, contract.exercise);
+}
+
+MarketDataStore::MarketDataStore() : epoch_(0) {
+    for (size_t i = 0; i < MAX_READERS; ++i) {
+        slots_[i].epoch.store(IDLE);
+    }
+    
+    MarketSnapshot* empty = new MarketSnapshot();
+    empty->version_ = 0;
+    empty->names_ = std::make_shared<const MarketSnapshot::Names>();
+    current_.store(empty);
+}
+
+MarketDataStore::~MarketDataStore() {
+    delete current_.load();
+    for (auto it = retired_.begin(); it != retired_.end(); ++it) {
+        delete it->second;
+    }
+}
+
+size_t MarketDataStore::addInstrument(const std::string& name, const MarketQuote& quote) {
+    validate(quote);
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    const MarketSnapshot* current = current_.load();
+    if (current->find(name) != MarketSnapshot::npos) {
+        throw std::invalid_argument("Instrument already exists: " + name);
+    }
+    return append(current, name, quote);
+}
+
+uint64_t MarketDataStore::set(const std::string& name, const MarketQuote& quote) {
+    validate(quote);
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    const MarketSnapshot* current = current_.load();
+    // Publishing may reclaim current, so take the new version first
+    uint64_t version = current->version_ + 1;
+    size_t instrument = current->find(name);
+    if (instrument == MarketSnapshot::npos) {
+        append(current, name, quote);
+    } else {
+        std::unique_ptr<MarketSnapshot> next(new MarketSnapshot(*current));
+        next->version_ = current->version_ + 1;
+        next->quotes_[instrument] = quote;
+        publish(next.release());
+    }
+    return version;
+}
+
+// Called with writeMutex_ held
+size_t MarketDataStore::append(const MarketSnapshot* current, const std::string& name, const MarketQuote& quote) {
+    auto names = std::make_shared<MarketSnapshot::Names>(*current->names_);
+    size_t instrument = names->names.size();
+    names->names.push_back(name);
+    names->index.emplace(name, instrument);
+    
+    std::unique_ptr<MarketSnapshot> next(new MarketSnapshot(*current));
+    next->version_ = current->version_ + 1;
+    next->quotes_.push_back(quote);
+    next->names_ = names;
+    publish(next.release());
+    return instrument;
+}
+
+void MarketDataStore::update(size_t instrument, const MarketQuote& quote) {
+    update(std::vector<std::pair<size_t, MarketQuote>>(1, std::make_pair(instrument, quote)));
+}
+
+void MarketDataStore::update(const std::vector<std::pair<size_t, MarketQuote>>& quotes) {
+    for (auto it = quotes.begin(); it != quotes.end(); ++it) {
+        validate(it->second);
+    }
+    
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    const MarketSnapshot* current = current_.load();
+    std::unique_ptr<MarketSnapshot> next(new MarketSnapshot(*current));
+    next->version_ = current->version_ + 1;
+    for (auto it = quotes.begin(); it != quotes.end(); ++it) {
+        if (it->first >= next->quotes_.size()) {
+            throw std::out_of_range("Unknown instrument in market update");
+        }
+        next->quotes_[it->first] = it->second;
+    }
+    publish(next.release());
+}
+
+uint64_t MarketDataStore::getVersion() const {
+    return current_.load()->version_;
+}
+
+size_t MarketDataStore::getRetiredCount() const {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    return retired_.size();
+}
+
+void MarketDataStore::publish(const MarketSnapshot* next) {
+    // Swap first, then advance the epoch: a reader announcing the new epoch is
+    // guaranteed to load the new pointer, so only announcements at or before
+    // the retire epoch can still reference the old snapshot
+    const MarketSnapshot* previous = current_.exchange(next);
+    uint64_t retiredAt = epoch_.fetch_add(1);
+    retired_.push_back(std::make_pair(retiredAt, previous));
+    reclaim();
+}
+
+void MarketDataStore::reclaim() {
+    uint64_t oldestActive = IDLE;
+    for (size_t i = 0; i < MAX_READERS; ++i) {
+        oldestActive = std::min(oldestActive, slots_[i].epoch.load());
+    }
+    {
+        std::lock_guard<std::mutex> lock(overflowMutex_);
+        for (auto it = overflowEpochs_.begin(); it != overflowEpochs_.end(); ++it) {
+            oldestActive = std::min(oldestActive, *it);
+        }
+    }
+    
+    size_t kept = 0;
+    for (size_t i = 0; i < retired_.size(); ++i) {
+        if (retired_[i].first < oldestActive) {
+            delete retired_[i].second;
+        } else {
+            retired_[kept++] = retired_[i];
+        }
+    }
+    retired_.resize(kept);
+}
+
+void MarketDataStore::validate(const MarketQuote& quote) {
+    if (quote.spot <= 0.0) {
+        throw std::invalid_argument("Spot price must be positive");
+    }
+    if (quote.volatility <= 0.0) {
+        throw std::invalid_argument("Volatility must be positive");
+    }
+}
+
+MarketDataStore::ReadGuard::ReadGuard(const MarketDataStore& store)
+    : store_(store), slot_(0), overflowEpoch_(0), snapshot_(nullptr) {
+    // Start probing where this thread last found a free slot
+    static thread_local size_t hint = std::hash<std::thread::id>()(std::this_thread::get_id());
+    
+    for (size_t probe = 0; probe < MAX_READERS; ++probe) {
+        size_t slot = (hint + probe) % MAX_READERS;
+        uint64_t expected = IDLE;
+        if (store.slots_[slot].epoch.compare_exchange_strong(expected, store.epoch_.load())) {
+            hint = slot;
+            slot_ = slot;
+            snapshot_ = store.current_.load();
+            return;
+        }
+    }
+    
+    // Every slot is taken: announce under the overflow lock instead. The writer
+    // reads the list under the same lock, so the usual epoch argument holds.
+    std::lock_guard<std::mutex> lock(store.overflowMutex_);
+    slot_ = MAX_READERS;
+    overflowEpoch_ = store.epoch_.load();
+    store.overflowEpochs_.push_back(overflowEpoch_);
+    snapshot_ = store.current_.load();
+}
+
+MarketDataStore::ReadGuard::~ReadGuard() {
+    if (slot_ < MAX_READERS) {
+        store_.slots_[slot_].epoch.store(IDLE);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(store_.overflowMutex_);
+    std::vector<uint64_t>& epochs = store_.overflowEpochs_;
+    epochs.erase(std::find(epochs.begin(), epochs.end(), overflowEpoch_));
+}
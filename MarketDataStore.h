@@ -0,0 +1,131 @@
+// MarketDataStore.h
+#ifndef MARKET_DATA_STORE_H
+#define MARKET_DATA_STORE_H
+
+#include "Option.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+struct MarketQuote {
+    double spot;
+    double rate;
+    double volatility;
+};
+
+// Contract terms of an option; the market side comes from a snapshot
+struct OptionContract {
+    size_t instrument;
+    double strike;
+    double timeToMaturity;
+    OptionType type;
+    ExerciseType exercise;
+};
+
+// Immutable, versioned view of all instruments' market state
+class MarketSnapshot {
+public:
+    static const size_t npos = static_cast<size_t>(-1);
+    
+    uint64_t getVersion() const { return version_; }
+    size_t size() const { return quotes_.size(); }
+    const MarketQuote& quote(size_t instrument) const { return quotes_[instrument]; }
+    const std::string& name(size_t instrument) const { return names_->names[instrument]; }
+    size_t find(const std::string& name) const;
+    
+    Option makeOption(const OptionContract& contract) const;
+
+private:
+    friend class MarketDataStore;
+    
+    // Only changes when an instrument is added, so snapshots share it
+    struct Names {
+        std::vector<std::string> names;
+        std::unordered_map<std::string, size_t> index;
+    };
+    
+    uint64_t version_;
+    std::vector<MarketQuote> quotes_;
+    std::shared_ptr<const Names> names_;
+};
+
+// Single-writer, many-reader market state. Writers copy the current snapshot,
+// apply their changes and publish the copy with an atomic pointer swap; readers
+// pin a snapshot for the lifetime of a ReadGuard without locking or allocating.
+// Replaced snapshots are reclaimed once every reader that could still see them
+// has moved past the epoch in which they were retired. Up to MAX_READERS guards
+// announce their epoch in lock-free slots; guards beyond that fall back to a
+// mutex-protected overflow list rather than failing, so bursts of readers only
+// slow down.
+class MarketDataStore {
+public:
+    MarketDataStore();
+    ~MarketDataStore();
+    
+    MarketDataStore(const MarketDataStore&) = delete;
+    MarketDataStore& operator=(const MarketDataStore&) = delete;
+    
+    // Writer side; each call publishes exactly one new version
+    size_t addInstrument(const std::string& name, const MarketQuote& quote);
+    void update(size_t instrument, const MarketQuote& quote);
+    void update(const std::vector<std::pair<size_t, MarketQuote>>& quotes);
+    
+    // Adds the instrument or replaces its quote in one step under the writer
+    // lock, so concurrent first quotes for a name cannot race. Returns the
+    // version it published.
+    uint64_t set(const std::string& name, const MarketQuote& quote);
+    
+    uint64_t getVersion() const;
+    size_t getRetiredCount() const;
+    
+    // Pins the current snapshot. Guards are cheap to create per request but must
+    // not outlive the store.
+    class ReadGuard {
+    public:
+        explicit ReadGuard(const MarketDataStore& store);
+        ~ReadGuard();
+        
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+        
+        const MarketSnapshot& operator*() const { return *snapshot_; }
+        const MarketSnapshot* operator->() const { return snapshot_; }
+    
+    private:
+        const MarketDataStore& store_;
+        size_t slot_;               // MAX_READERS when announced in the overflow list
+        uint64_t overflowEpoch_;
+        const MarketSnapshot* snapshot_;
+    };
+
+private:
+    // One reader announcement per cache line; IDLE marks a free slot
+    struct ReaderSlot {
+        std::atomic<uint64_t> epoch;
+        char padding[64 - sizeof(std::atomic<uint64_t>)];
+    };
+    
+    static const size_t MAX_READERS = 256;
+    static const uint64_t IDLE = UINT64_MAX;
+    
+    mutable ReaderSlot slots_[MAX_READERS];
+    mutable std::mutex overflowMutex_;
+    mutable std::vector<uint64_t> overflowEpochs_;
+    std::atomic<const MarketSnapshot*> current_;
+    std::atomic<uint64_t> epoch_;
+    
+    mutable std::mutex writeMutex_;
+    std::vector<std::pair<uint64_t, const MarketSnapshot*>> retired_;
+    
+    void publish(const MarketSnapshot* next);
+    size_t append(const MarketSnapshot* current, const std::string& name, const MarketQuote& quote);
+    void reclaim();
+    static void validate(const MarketQuote& quote);
+};
+
+#endif
@@ -1,81 +1,138 @@
 #include "MonteCarloEngine.h"
+#include "Payoff.h"
 #include <cmath>
 #include <numeric>
 #include <stdexcept>
 
-double MonteCarloEngine::price(const Option& option) {
+double MonteCarloEngine::price(const Option& quoted, const PricingConfig& config) const {
+    const Option option = resolveMarketData(quoted, config);
     if (option.getExerciseType() == ExerciseType::AMERICAN) {
         throw std::invalid_argument("Basic Monte Carlo doesn't support American options");
     }
     
-    std::vector<double> payoffs;
-    payoffs.reserve(numSimulations_);
-    
-    for (int i = 0; i < numSimulations_; ++i) {
-        double randomNormal = normalDist_(generator_);
-        double finalSpotPrice = simulateSpotPrice(option, randomNormal);
-        payoffs.push_back(option.payoff(finalSpotPrice));
+    // The market data is resolved once here, so dispatch to the unresolved variants
+    switch (config.scheme) {
+        case MonteCarloScheme::ANTITHETIC:
+            if (option.getOptionType() == OptionType::CALL) {
+                return priceAntithetic<OptionType::CALL>(option, config);
+            }
+            return priceAntithetic<OptionType::PUT>(option, config);
+        case MonteCarloScheme::CONTROL_VARIATE:
+            if (option.getOptionType() == OptionType::CALL) {
+                return priceControlVariate<OptionType::CALL>(option, config);
+            }
+            return priceControlVariate<OptionType::PUT>(option, config);
+        default:
+            if (option.getOptionType() == OptionType::CALL) {
+                return priceStandard<OptionType::CALL>(option, config);
+            }
+            return priceStandard<OptionType::PUT>(option, config);
+    }
+}
+
+template <OptionType Type>
+double MonteCarloEngine::priceStandard(const Option& option, const PricingConfig& config) const {
+    std::mt19937 generator(config.seed);
+    std::normal_distribution<double> normalDist(0.0, 1.0);
+    const VanillaPayoff<Type> payoff(option.getStrike());
+    
+    // Terminal spot is S * exp(drift + diffusion * z); both terms are per-option constants
+    double sigma = option.getVolatility();
+    double T = option.getTimeToMaturity();
+    double drift = (option.getRate() - option.getDividendYield() - 0.5 * sigma * sigma) * T;
+    double diffusion = sigma * std::sqrt(T);
+    double spot = option.getSpot();
+    
+    // Accumulate in place rather than storing every payoff
+    double payoffSum = 0.0;
+    for (int i = 0; i < config.monteCarloSimulations; ++i) {
+        double randomNormal = normalDist(generator);
+        payoffSum += payoff(spot * std::exp(drift + diffusion * randomNormal));
     }
     
-    double averagePayoff = std::accumulate(payoffs.begin(), payoffs.end(), 0.0) / numSimulations_;
+    double averagePayoff = payoffSum / config.monteCarloSimulations;
     return std::exp(-option.getRate() * option.getTimeToMaturity()) * averagePayoff;
 }
 
-double MonteCarloEngine::simulateSpotPrice(const Option& option, double randomNormal) {
-    double drift = (option.getRate() - 0.5 * option.getVolatility() * option.getVolatility()) * 
-                   option.getTimeToMaturity();
-    double diffusion = option.getVolatility() * std::sqrt(option.getTimeToMaturity()) * randomNormal;
-    
-    return option.getSpot() * std::exp(drift + diffusion);
+double MonteCarloEngine::priceWithAntithetic(const Option& quoted, const PricingConfig& config) const {
+    const Option option = resolveMarketData(quoted, config);
+    if (option.getOptionType() == OptionType::CALL) {
+        return priceAntithetic<OptionType::CALL>(option, config);
+    }
+    return priceAntithetic<OptionType::PUT>(option, config);
 }
 
-double MonteCarloEngine::priceWithAntithetic(const Option& option) {
-    std::vector<double> payoffs;
-    payoffs.reserve(numSimulations_);
-    
-    for (int i = 0; i < numSimulations_ / 2; ++i) {
-        double randomNormal = normalDist_(generator_);
+template <OptionType Type>
+double MonteCarloEngine::priceAntithetic(const Option& option, const PricingConfig& config) const {
+    std::mt19937 generator(config.seed);
+    std::normal_distribution<double> normalDist(0.0, 1.0);
+    const VanillaPayoff<Type> payoff(option.getStrike());
+    
+    double sigma = option.getVolatility();
+    double T = option.getTimeToMaturity();
+    double drift = (option.getRate() - option.getDividendYield() - 0.5 * sigma * sigma) * T;
+    double diffusion = sigma * std::sqrt(T);
+    double spot = option.getSpot();
+    
+    int numPairs = config.monteCarloSimulations / 2;
+    double payoffSum = 0.0;
+    for (int i = 0; i < numPairs; ++i) {
+        double randomNormal = normalDist(generator);
         
         // Original path
-        double finalSpotPrice1 = simulateSpotPrice(option, randomNormal);
-        payoffs.push_back(option.payoff(finalSpotPrice1));
+        payoffSum += payoff(spot * std::exp(drift + diffusion * randomNormal));
         
         // Antithetic path
-        double finalSpotPrice2 = simulateSpotPrice(option, -randomNormal);
-        payoffs.push_back(option.payoff(finalSpotPrice2));
+        payoffSum += payoff(spot * std::exp(drift - diffusion * randomNormal));
     }
     
-    double averagePayoff = std::accumulate(payoffs.begin(), payoffs.end(), 0.0) / payoffs.size();
+    double averagePayoff = payoffSum / (2.0 * numPairs);
     return std::exp(-option.getRate() * option.getTimeToMaturity()) * averagePayoff;
 }
 
-double MonteCarloEngine::priceWithControlVariate(const Option& option) {
-    // Simple control variate implementation using geometric average
-    std::vector<double> payoffs;
-    std::vector<double> controlVariates;
-    payoffs.reserve(numSimulations_);
-    controlVariates.reserve(numSimulations_);
-    
-    for (int i = 0; i < numSimulations_; ++i) {
-        double randomNormal = normalDist_(generator_);
-        double finalSpotPrice = simulateSpotPrice(option, randomNormal);
+double MonteCarloEngine::priceWithControlVariate(const Option& quoted, const PricingConfig& config) const {
+    const Option option = resolveMarketData(quoted, config);
+    if (option.getOptionType() == OptionType::CALL) {
+        return priceControlVariate<OptionType::CALL>(option, config);
+    }
+    return priceControlVariate<OptionType::PUT>(option, config);
+}
+
+template <OptionType Type>
+double MonteCarloEngine::priceControlVariate(const Option& option, const PricingConfig& config) const {
+    // Control variate on the terminal spot, whose discounted mean is known exactly.
+    // Running sums replace the stored samples; the estimator is unchanged.
+    std::mt19937 generator(config.seed);
+    std::normal_distribution<double> normalDist(0.0, 1.0);
+    const VanillaPayoff<Type> vanillaPayoff(option.getStrike());
+    
+    double sigma = option.getVolatility();
+    double T = option.getTimeToMaturity();
+    double drift = (option.getRate() - option.getDividendYield() - 0.5 * sigma * sigma) * T;
+    double diffusion = sigma * std::sqrt(T);
+    double spot = option.getSpot();
+    
+    const int n = config.monteCarloSimulations;
+    double forward = spot * std::exp((option.getRate() - option.getDividendYield()) * T);
+    double payoffSum = 0.0, cvSum = 0.0, crossSum = 0.0, cvSquareSum = 0.0;
+    
+    for (int i = 0; i < n; ++i) {
+        double randomNormal = normalDist(generator);
+        double finalSpotPrice = spot * std::exp(drift + diffusion * randomNormal);
         
-        payoffs.push_back(option.payoff(finalSpotPrice));
-        controlVariates.push_back(finalSpotPrice - option.getSpot() * 
-                                 std::exp(option.getRate() * option.getTimeToMaturity()));
+        double payoff = vanillaPayoff(finalSpotPrice);
+        double controlVariate = finalSpotPrice - forward;
+        payoffSum += payoff;
+        cvSum += controlVariate;
+        crossSum += payoff * controlVariate;
+        cvSquareSum += controlVariate * controlVariate;
     }
     
     // Calculate control variate coefficient
-    double payoffMean = std::accumulate(payoffs.begin(), payoffs.end(), 0.0) / numSimulations_;
-    double cvMean = std::accumulate(controlVariates.begin(), controlVariates.end(), 0.0) / numSimulations_;
-    
-    double covariance = 0.0;
-    double cvVariance = 0.0;
-    
-    for (int i = 0; i < numSimulations_; ++i) {
-        covariance += (payoffs[i] - payoffMean) * (controlVariates[i] - cvMean);
-        cvVariance += (controlVariates[i] - cvMean) * (controlVariates[i] - cvMean);
-    }
+    double payoffMean = payoffSum / n;
+    double cvMean = cvSum / n;
+    double covariance = crossSum - n * payoffMean * cvMean;
+    double cvVariance = cvSquareSum - n * cvMean * cvMean;
     
     double beta = covariance / cvVariance;
     
@@ -85,7 +142,61 @@ double MonteCarloEngine::priceWithControlVariate(const Option& option) {
     return std::exp(-option.getRate() * option.getTimeToMaturity()) * adjustedPayoff;
 }
 
-std::vector<double> MonteCarloEngine::generatePath(const Option& option, int numSteps) {
+void MonteCarloEngine::evolvePaths(double spot, double rate, double volatility, const std::vector<double>& timeGrid,
+                                   size_t numPaths, double* values) const {
+    double previousTime = 0.0;
+    const double* previousSpots = nullptr;
+    for (size_t date = 0; date < timeGrid.size(); ++date) {
+        double dt = timeGrid[date] - previousTime;
+        if (dt < 0.0) {
+            throw std::invalid_argument("Time grid must be increasing");
+        }
+        double drift = (rate - 0.5 * volatility * volatility) * dt;
+        double diffusion = volatility * std::sqrt(dt);
+        
+        // Dates are contiguous across paths, so each step is one pass over a row
+        double* row = values + date * numPaths;
+        for (size_t path = 0; path < numPaths; ++path) {
+            double start = previousSpots ? previousSpots[path] : spot;
+            row[path] = start * std::exp(drift + diffusion * row[path]);
+        }
+        previousTime = timeGrid[date];
+        previousSpots = row;
+    }
+}
+
+void MonteCarloEngine::evolvePaths(double spot, const std::vector<double>& forwards, double volatility,
+                                   const std::vector<double>& timeGrid, size_t numPaths, double* values) const {
+    if (forwards.size() != timeGrid.size()) {
+        throw std::invalid_argument("Need one forward per date");
+    }
+    double previousTime = 0.0;
+    double previousForward = spot;
+    const double* previousSpots = nullptr;
+    for (size_t date = 0; date < timeGrid.size(); ++date) {
+        double dt = timeGrid[date] - previousTime;
+        if (dt < 0.0) {
+            throw std::invalid_argument("Time grid must be increasing");
+        }
+        if (forwards[date] <= 0.0) {
+            throw std::invalid_argument("Forwards must be positive");
+        }
+        double drift = std::log(forwards[date] / previousForward) - 0.5 * volatility * volatility * dt;
+        double diffusion = volatility * std::sqrt(dt);
+        
+        double* row = values + date * numPaths;
+        for (size_t path = 0; path < numPaths; ++path) {
+            double start = previousSpots ? previousSpots[path] : spot;
+            row[path] = start * std::exp(drift + diffusion * row[path]);
+        }
+        previousTime = timeGrid[date];
+        previousForward = forwards[date];
+        previousSpots = row;
+    }
+}
+
+std::vector<double> MonteCarloEngine::generatePath(const Option& option, std::mt19937& generator, int numSteps) const {
+    std::normal_distribution<double> normalDist(0.0, 1.0);
     std::vector<double> path;
     path.reserve(numSteps + 1);
     
@@ -94,9 +205,10 @@ std::vector<double> MonteCarloEngine::generatePath(const Option& option, int num
     path.push_back(currentPrice);
     
     for (int i = 0; i < numSteps; ++i) {
-        double randomNormal = normalDist_(generator_);
-        double drift = (option.getRate() - 0.5 * option.getVolatility() * option.getVolatility()) * dt;
-        double diffusion = option.getVolatility() * std::sqrt(dt) * randomNormal;
+        double randomNormal = normalDist(generator);
+        double sigma = option.getVolatility();
+        double drift = (option.getRate() - option.getDividendYield() - 0.5 * sigma * sigma) * dt;
+        double diffusion = sigma * std::sqrt(dt) * randomNormal;
         
         currentPrice *= std::exp(drift + diffusion);
         path.push_back(currentPrice);
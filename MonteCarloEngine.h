@@ -8,25 +8,36 @@
 
 class MonteCarloEngine : public PricingEngine {
 public:
-    MonteCarloEngine(int numSimulations = 100000, int seed = 42) 
-        : numSimulations_(numSimulations), generator_(seed) {}
-    
-    double price(const Option& option) override;
+    // Dispatches on config.scheme; every call draws from its own generator seeded
+    // with config.seed, so results are reproducible and calls are reentrant
+    using PricingEngine::price;
+    double price(const Option& option, const PricingConfig& config) const override;
     std::string getMethodName() const override { return "Monte Carlo"; }
     
-    void setNumSimulations(int numSimulations) { numSimulations_ = numSimulations; }
-    
     // Advanced features
-    double priceWithAntithetic(const Option& option);
-    double priceWithControlVariate(const Option& option);
+    double priceWithAntithetic(const Option& option, const PricingConfig& config) const;
+    double priceWithControlVariate(const Option& option, const PricingConfig& config) const;
+    
+    // Exact GBM paths on an increasing time grid starting after t = 0. On entry
+    // values[date * numPaths + path] holds standard normals; on return, spots.
+    void evolvePaths(double spot, double rate, double volatility, const std::vector<double>& timeGrid,
+                     size_t numPaths, double* values) const;
+    
+    // Same, drifting along a forward curve: forwards[date] is the risk-neutral
+    // forward of the spot to timeGrid[date], so term structures and dividends carry
+    void evolvePaths(double spot, const std::vector<double>& forwards, double volatility,
+                     const std::vector<double>& timeGrid, size_t numPaths, double* values) const;
 
 private:
-    int numSimulations_;
-    std::mt19937 generator_;
-    std::normal_distribution<double> normalDist_{0.0, 1.0};
+    // Payoff type is fixed per call so the path loops carry no type branch
+    template <OptionType Type>
+    double priceStandard(const Option& option, const PricingConfig& config) const;
+    template <OptionType Type>
+    double priceAntithetic(const Option& option, const PricingConfig& config) const;
+    template <OptionType Type>
+    double priceControlVariate(const Option& option, const PricingConfig& config) const;
     
-    double simulateSpotPrice(const Option& option, double randomNormal);
-    std::vector<double> generatePath(const Option& option, int numSteps = 252);
+    std::vector<double> generatePath(const Option& option, std::mt19937& generator, int numSteps = 252) const;
 };
 
 #endif
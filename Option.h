@@ -15,9 +15,10 @@ enum class PositionType { LONG, SHORT };
 class Option {
 public:
     Option(double spot, double strike, double rate, double volatility, 
-           double timeToMaturity, OptionType type, ExerciseType exercise)
+           double timeToMaturity, OptionType type, ExerciseType exercise,
+           double dividendYield = 0.0)
         : S0_(spot), K_(strike), r_(rate), sigma_(volatility), 
-          T_(timeToMaturity), optionType_(type), exerciseType_(exercise) {}
+          T_(timeToMaturity), q_(dividendYield), optionType_(type), exerciseType_(exercise) {}
     
     // Getters
     double getSpot() const { return S0_; }
@@ -25,6 +26,7 @@ public:
     double getRate() const { return r_; }
     double getVolatility() const { return sigma_; }
     double getTimeToMaturity() const { return T_; }
+    double getDividendYield() const { return q_; }
     OptionType getOptionType() const { return optionType_; }
     ExerciseType getExerciseType() const { return exerciseType_; }
     
@@ -48,7 +50,7 @@ public:
     }
 
 private:
-    double S0_, K_, r_, sigma_, T_;
+    double S0_, K_, r_, sigma_, T_, q_;
     OptionType optionType_;
     ExerciseType exerciseType_;
 };
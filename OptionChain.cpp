@@ -0,0 +1,117 @@
+#include "OptionChain.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+size_t OptionChain::addUnderlying(const std::string& name, double spot, double rate) {
+    Underlying underlying;
+    underlying.name = name;
+    underlying.spot = spot;
+    underlying.rate = rate;
+    underlyings_.push_back(underlying);
+    return underlyings_.size() - 1;
+}
+
+void OptionChain::setTermStructure(size_t underlying, std::shared_ptr<const TermStructure> termStructure) {
+    if (underlying >= underlyings_.size()) {
+        throw std::invalid_argument("Unknown underlying index");
+    }
+    underlyings_[underlying].termStructure = termStructure;
+    finalized_ = false;
+}
+
+size_t OptionChain::addOption(size_t underlying, double strike, double timeToMaturity, double volatility,
+                              OptionType type, ExerciseType exercise, double quantity) {
+    if (underlying >= underlyings_.size()) {
+        throw std::invalid_argument("Unknown underlying index");
+    }
+    
+    strike_.push_back(strike);
+    expiry_.push_back(timeToMaturity);
+    volatility_.push_back(volatility);
+    quantity_.push_back(quantity);
+    type_.push_back(type);
+    exercise_.push_back(exercise);
+    underlying_.push_back(underlying);
+    id_.push_back(id_.size());
+    finalized_ = false;
+    return id_.back();
+}
+
+template <class Column>
+void OptionChain::permute(Column& column, const std::vector<size_t>& order) {
+    Column sorted;
+    sorted.reserve(column.size());
+    for (auto it = order.begin(); it != order.end(); ++it) {
+        sorted.push_back(column[*it]);
+    }
+    column.swap(sorted);
+}
+
+void OptionChain::finalize() {
+    std::vector<size_t> order(size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        if (underlying_[a] != underlying_[b]) return underlying_[a] < underlying_[b];
+        return expiry_[a] < expiry_[b];
+    });
+    
+    permute(strike_, order);
+    permute(expiry_, order);
+    permute(volatility_, order);
+    permute(quantity_, order);
+    permute(type_, order);
+    permute(exercise_, order);
+    permute(underlying_, order);
+    permute(id_, order);
+    
+    groups_.clear();
+    for (size_t leg = 0; leg < size(); ++leg) {
+        if (groups_.empty() || groups_.back().underlying != underlying_[leg] ||
+            groups_.back().timeToMaturity != expiry_[leg]) {
+            ExpiryGroup group;
+            group.underlying = underlying_[leg];
+            group.timeToMaturity = expiry_[leg];
+            group.sqrtT = std::sqrt(expiry_[leg]);
+            setFactors(group);
+            group.begin = leg;
+            group.end = leg;
+            groups_.push_back(group);
+        }
+        groups_.back().end = leg + 1;
+    }
+    
+    finalized_ = true;
+}
+
+void OptionChain::setFactors(ExpiryGroup& group) const {
+    const Underlying& underlying = underlyings_[group.underlying];
+    double T = group.timeToMaturity;
+    
+    if (underlying.termStructure) {
+        TermStructure::Factors factors = underlying.termStructure->factorsAt(T);
+        if (factors.dividendPV >= underlying.spot) {
+            throw std::invalid_argument("Cash dividends exceed the spot price of " + underlying.name);
+        }
+        group.discountFactor = factors.discountFactor;
+        group.rate = factors.rate;
+        group.dividendYield = factors.dividendYield;
+        group.dividendFactor = factors.dividendFactor;
+        group.dividendPV = factors.dividendPV;
+    } else {
+        group.discountFactor = std::exp(-underlying.rate * T);
+        group.rate = underlying.rate;
+        group.dividendYield = 0.0;
+        group.dividendFactor = 1.0;
+        group.dividendPV = 0.0;
+    }
+    group.forward = (underlying.spot - group.dividendPV) * group.dividendFactor / group.discountFactor;
+}
+
+Option OptionChain::toOption(size_t leg) const {
+    const Underlying& underlying = underlyings_[underlying_[leg]];
+    Option option(underlying.spot, strike_[leg], underlying.rate, volatility_[leg],
+                  expiry_[leg], type_[leg], exercise_[leg]);
+    return underlying.termStructure ? underlying.termStructure->applyTo(option) : option;
+}
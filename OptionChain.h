@@ -0,0 +1,94 @@
+// OptionChain.h
+#ifndef OPTION_CHAIN_H
+#define OPTION_CHAIN_H
+
+#include "Option.h"
+#include "AlignedAllocator.h"
+#include "TermStructure.h"
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Structure-of-arrays book of options. Legs are stored as aligned columns and,
+// after finalize(), ordered by underlying then expiry so each (underlying, expiry)
+// group is a contiguous range sharing its discount factor and sqrt(T).
+class OptionChain {
+public:
+    struct Underlying {
+        std::string name;
+        double spot;
+        double rate;
+        std::shared_ptr<const TermStructure> termStructure;  // null: flat rate, no dividends
+    };
+    
+    // Rate and dividend factors are evaluated once per group at finalize()
+    struct ExpiryGroup {
+        size_t underlying;
+        double timeToMaturity;
+        double sqrtT;
+        double discountFactor;
+        double rate;            // zero rate to expiry
+        double dividendYield;   // continuous dividend yield to expiry
+        double dividendFactor;  // exp(-dividendYield * T)
+        double dividendPV;      // present value of cash dividends paid before expiry
+        double forward;         // forward of the underlying's spot to expiry
+        size_t begin, end;      // leg range [begin, end)
+        
+        // Spot net of cash dividends, discounted at the dividend yield; floored at
+        // zero so spot shocks below the dividends price as a zero forward
+        double prepaidSpot(double spot) const {
+            return std::max(spot - dividendPV, 0.0) * dividendFactor;
+        }
+    };
+    
+    size_t addUnderlying(const std::string& name, double spot, double rate);
+    
+    // Rates and dividends for the underlying's expiries; replaces its flat rate
+    void setTermStructure(size_t underlying, std::shared_ptr<const TermStructure> termStructure);
+    
+    size_t addOption(size_t underlying, double strike, double timeToMaturity, double volatility,
+                     OptionType type, ExerciseType exercise, double quantity = 1.0);
+    
+    // Sorts legs into (underlying, expiry) groups; required before pricing
+    void finalize();
+    bool isFinalized() const { return finalized_; }
+    
+    size_t size() const { return strike_.size(); }
+    Option toOption(size_t leg) const;
+    
+    const std::vector<Underlying>& getUnderlyings() const { return underlyings_; }
+    const std::vector<ExpiryGroup>& getExpiryGroups() const { return groups_; }
+    
+    const double* strikes() const { return strike_.data(); }
+    const double* expiries() const { return expiry_.data(); }
+    const double* volatilities() const { return volatility_.data(); }
+    const double* quantities() const { return quantity_.data(); }
+    const OptionType* types() const { return type_.data(); }
+    const ExerciseType* exercises() const { return exercise_.data(); }
+    const size_t* underlyingIndices() const { return underlying_.data(); }
+    
+    // Id returned by addOption for the leg now stored at this position
+    size_t legId(size_t leg) const { return id_[leg]; }
+
+private:
+    std::vector<Underlying> underlyings_;
+    std::vector<ExpiryGroup> groups_;
+    
+    AlignedVector<double> strike_;
+    AlignedVector<double> expiry_;
+    AlignedVector<double> volatility_;
+    AlignedVector<double> quantity_;
+    AlignedVector<OptionType> type_;
+    AlignedVector<ExerciseType> exercise_;
+    AlignedVector<size_t> underlying_;
+    AlignedVector<size_t> id_;
+    bool finalized_ = false;
+    
+    void setFactors(ExpiryGroup& group) const;
+    
+    template <class Column>
+    static void permute(Column& column, const std::vector<size_t>& order);
+};
+
+#endif
@@ -5,39 +5,182 @@
 OptionsPricingEngine::OptionsPricingEngine() 
     : blackScholesEngine_(std::make_unique<BlackScholesEngine>()),
       binomialEngine_(std::make_unique<BinomialEngine>()),
-      monteCarloEngine_(std::make_unique<MonteCarloEngine>()) {
+      monteCarloEngine_(std::make_unique<MonteCarloEngine>()),
+      fourierEngine_(std::make_unique<FourierEngine>()),
+      methodDeadline_(std::chrono::seconds(30)),
+      maxOutstandingPerMethod_(static_cast<int>(2 * ThreadPool::defaultThreadCount())),
+      shed_(0), skipped_(0) {
     
-    pricingFunctions_["BlackScholes"] = [this](const Option& option) {
-        return blackScholesEngine_->price(option);
+    pricingFunctions_["BlackScholes"] = [this](const Option& option, const PricingConfig& config) {
+        return blackScholesEngine_->price(option, config);
     };
     
-    pricingFunctions_["Binomial"] = [this](const Option& option) {
-        return binomialEngine_->price(option);
+    pricingFunctions_["Binomial"] = [this](const Option& option, const PricingConfig& config) {
+        return binomialEngine_->price(option, config);
     };
     
-    pricingFunctions_["MonteCarlo"] = [this](const Option& option) {
-        return monteCarloEngine_->price(option);
+    pricingFunctions_["MonteCarlo"] = [this](const Option& option, const PricingConfig& config) {
+        return monteCarloEngine_->price(option, config);
     };
+    
+    pricingFunctions_["Fourier"] = [this](const Option& option, const PricingConfig& config) {
+        return fourierEngine_->price(option, config);
+    };
+    
+    for (auto it = pricingFunctions_.begin(); it != pricingFunctions_.end(); ++it) {
+        outstanding_[it->first].reset(new std::atomic<int>(0));
+    }
 }
 
 double OptionsPricingEngine::price(const Option& option, const std::string& method) {
+    return price(option, method, defaultConfig_);
+}
+
+double OptionsPricingEngine::price(const Option& option, const std::string& method, const PricingConfig& config) {
     auto it = pricingFunctions_.find(method);
     if (it == pricingFunctions_.end()) {
         throw std::invalid_argument("Unknown pricing method: " + method);
     }
     
-    return it->second(option);
+    return priceCached(option, method, config);
+}
+
+PricingKey OptionsPricingEngine::makeCacheKey(const Option& option, const std::string& method,
+                                              const PricingConfig& config) const {
+    if (method == "Binomial") {
+        // The scheme slot records whether price tables may replace the tree
+        return PricingKey(option, method, config.binomialSteps, 0, 0, config.useAmericanPriceTables ? 1 : 0);
+    }
+    if (method == "MonteCarlo") {
+        return PricingKey(option, method, 0, config.monteCarloSimulations, config.seed,
+                          static_cast<int>(config.scheme));
+    }
+    return PricingKey(option, method);
+}
+
+double OptionsPricingEngine::priceCached(const Option& option, const std::string& method,
+                                         const PricingConfig& config) {
+    // Key on the volatility actually priced so surface changes never hit stale entries
+    PricingKey key = makeCacheKey(PricingEngine::resolveMarketData(option, config), method, config);
+    PricingCache::Entry entry;
+    if (cache_.lookup(key, entry)) {
+        return entry.price;
+    }
+    
+    // Identical requests already being priced by another thread share its result.
+    // Failures propagate to every waiter without being cached.
+    return inFlight_.run(key, [this, &key, &option, &method, &config]() {
+        PricingCache::Entry computed;
+        computed.price = pricingFunctions_.at(method)(option, config);
+        computed.seed = key.seed;
+        cache_.insert(key, computed);
+        return computed.price;
+    });
 }
 
 std::map<std::string, double> OptionsPricingEngine::priceAllMethods(const Option& option) {
+    return priceAllMethods(option, methodDeadline_);
+}
+
+std::map<std::string, double> OptionsPricingEngine::priceAllMethods(const Option& option,
+                                                                    std::chrono::milliseconds deadline,
+                                                                    std::vector<std::string>* timedOut) {
+    return priceAllMethods(option, defaultConfig_, deadline, timedOut);
+}
+
+std::map<std::string, double> OptionsPricingEngine::priceAllMethods(const Option& option,
+                                                                    const PricingConfig& config,
+                                                                    std::chrono::milliseconds deadline,
+                                                                    std::vector<std::string>* timedOut) {
+    std::vector<std::string> methods;
+    for (auto it = pricingFunctions_.begin(); it != pricingFunctions_.end(); ++it) {
+        methods.push_back(it->first);
+    }
+    
+    return priceConcurrently(option, methods, config, deadline, timedOut);
+}
+
+std::map<std::string, double> OptionsPricingEngine::priceMethods(const Option& option,
+                                                                 const std::vector<std::string>& methods) {
+    return priceMethods(option, methods, defaultConfig_);
+}
+
+std::map<std::string, double> OptionsPricingEngine::priceMethods(const Option& option,
+                                                                 const std::vector<std::string>& methods,
+                                                                 const PricingConfig& config) {
+    for (auto it = methods.begin(); it != methods.end(); ++it) {
+        if (pricingFunctions_.find(*it) == pricingFunctions_.end()) {
+            throw std::invalid_argument("Unknown pricing method: " + *it);
+        }
+    }
+    
+    // A single method gains nothing from the pool, so run it on the caller's thread
+    if (methods.size() != 1) {
+        return priceConcurrently(option, methods, config, methodDeadline_, nullptr);
+    }
+    
     std::map<std::string, double> results;
+    try {
+        results[methods[0]] = priceCached(option, methods[0], config);
+    } catch (const std::exception& e) {
+        results[methods[0]] = std::numeric_limits<double>::quiet_NaN();
+    }
     
-    // C++14 compatible - replace structured binding
-    for (auto it = pricingFunctions_.begin(); it != pricingFunctions_.end(); ++it) {
+    return results;
+}
+
+std::map<std::string, double> OptionsPricingEngine::priceConcurrently(const Option& option,
+                                                                      const std::vector<std::string>& methods,
+                                                                      const PricingConfig& config,
+                                                                      std::chrono::milliseconds deadline,
+                                                                      std::vector<std::string>* timedOut) {
+    std::chrono::steady_clock::time_point expiry = std::chrono::steady_clock::now() + deadline;
+    
+    std::map<std::string, double> results;
+    
+    // Tasks copy the option, method name and configuration so an abandoned task
+    // never references this call's stack frame
+    std::vector<std::pair<std::string, std::future<double>>> pending;
+    for (auto it = methods.begin(); it != methods.end(); ++it) {
+        std::string method = *it;
+        std::atomic<int>* outstanding = outstanding_.at(method).get();
+        if (outstanding->fetch_add(1) >= maxOutstandingPerMethod_) {
+            outstanding->fetch_sub(1);
+            ++shed_;
+            results[method] = std::numeric_limits<double>::quiet_NaN();
+            if (timedOut) {
+                timedOut->push_back(method);
+            }
+            continue;
+        }
+        
+        pending.emplace_back(method, pool_.submit([this, method, option, config, expiry, outstanding]() {
+            struct Release {
+                std::atomic<int>* counter;
+                ~Release() { counter->fetch_sub(1); }
+            } release = { outstanding };
+            
+            // Nobody is waiting for a task that starts after its deadline
+            if (std::chrono::steady_clock::now() >= expiry) {
+                ++skipped_;
+                return std::numeric_limits<double>::quiet_NaN();
+            }
+            return priceCached(option, method, config);
+        }));
+    }
+    
+    for (auto it = pending.begin(); it != pending.end(); ++it) {
         const std::string& name = it->first;
-        const std::function<double(const Option&)>& pricingFunc = it->second;
+        if (it->second.wait_until(expiry) != std::future_status::ready) {
+            results[name] = std::numeric_limits<double>::quiet_NaN();
+            if (timedOut) {
+                timedOut->push_back(name);
+            }
+            continue;
+        }
+        
         try {
-            results[name] = pricingFunc(option);
+            results[name] = it->second.get();
         } catch (const std::exception& e) {
             results[name] = std::numeric_limits<double>::quiet_NaN();
         }
@@ -46,8 +189,9 @@ std::map<std::string, double> OptionsPricingEngine::priceAllMethods(const Option
     return results;
 }
 
-std::map<std::string, double> OptionsPricingEngine::calculateGreeks(const Option& option) {
+std::map<std::string, double> OptionsPricingEngine::calculateGreeks(const Option& quoted) {
     std::map<std::string, double> greeks;
+    const Option option = PricingEngine::resolveMarketData(quoted, defaultConfig_);
     
     greeks["Delta"] = blackScholesEngine_->delta(option);
     greeks["Gamma"] = blackScholesEngine_->gamma(option);
@@ -58,10 +202,101 @@ std::map<std::string, double> OptionsPricingEngine::calculateGreeks(const Option
     return greeks;
 }
 
+double OptionsPricingEngine::price(const Option& option, PricingMethod method) {
+    return price(option, method, defaultConfig_);
+}
+
+double OptionsPricingEngine::price(const Option& option, PricingMethod method, const PricingConfig& config) {
+    // Checked up front so unsupported combinations never construct an exception
+    bool european = option.getExerciseType() == ExerciseType::EUROPEAN;
+    
+    switch (method) {
+        case PricingMethod::BLACK_SCHOLES:
+            return european ? blackScholesEngine_->price(option, config) : std::numeric_limits<double>::quiet_NaN();
+        case PricingMethod::BINOMIAL:
+            return binomialEngine_->price(option, config);
+        case PricingMethod::MONTE_CARLO:
+            return european ? monteCarloEngine_->price(option, config) : std::numeric_limits<double>::quiet_NaN();
+        case PricingMethod::FOURIER:
+            return european ? fourierEngine_->price(option, config) : std::numeric_limits<double>::quiet_NaN();
+    }
+    return std::numeric_limits<double>::quiet_NaN();
+}
+
+void OptionsPricingEngine::priceAllMethods(const Option& option, MethodPrices& out) {
+    for (int i = 0; i < MethodPrices::NUM_METHODS; ++i) {
+        out.values[i] = price(option, static_cast<PricingMethod>(i), defaultConfig_);
+    }
+}
+
+void OptionsPricingEngine::calculateGreeks(const Option& option, Greeks& out) {
+    blackScholesEngine_->greeks(PricingEngine::resolveMarketData(option, defaultConfig_), out);
+}
+
+const PricingEngine& OptionsPricingEngine::engineFor(PricingMethod method) const {
+    switch (method) {
+        case PricingMethod::BINOMIAL:
+            return *binomialEngine_;
+        case PricingMethod::MONTE_CARLO:
+            return *monteCarloEngine_;
+        case PricingMethod::FOURIER:
+            return *fourierEngine_;
+        default:
+            return *blackScholesEngine_;
+    }
+}
+
+void OptionsPricingEngine::setAmericanPriceTables(std::shared_ptr<const AmericanPriceTable> calls,
+                                                  std::shared_ptr<const AmericanPriceTable> puts) {
+    binomialEngine_->setAmericanPriceTables(calls, puts);
+    // Cached American tree prices would otherwise outlive the switch to tables
+    cache_.clear();
+}
+
+void OptionsPricingEngine::priceChain(const OptionChain& chain, PricingMethod method, std::vector<double>& out) {
+    priceChain(chain, method, defaultConfig_, out);
+}
+
+void OptionsPricingEngine::priceChain(const OptionChain& chain, PricingMethod method, const PricingConfig& config,
+                                      std::vector<double>& out) {
+    engineFor(method).priceChain(chain, config, out);
+}
+
+std::vector<double> OptionsPricingEngine::priceStrikeGrid(const Option& option, const std::vector<double>& strikes) {
+    BlackScholesModel model(PricingEngine::resolveMarketData(option, defaultConfig_).getVolatility());
+    return priceStrikeGrid(model, option, strikes);
+}
+
+std::vector<double> OptionsPricingEngine::priceStrikeGrid(const CharacteristicFunction& model, const Option& option,
+                                                          const std::vector<double>& strikes) {
+    if (option.getExerciseType() == ExerciseType::AMERICAN) {
+        throw std::invalid_argument("Strike grid pricing only supports European options");
+    }
+    
+    // The model supplies the volatility, so only the term structure applies here
+    PricingConfig rates;
+    rates.termStructure = defaultConfig_.termStructure;
+    const Option resolved = PricingEngine::resolveMarketData(option, rates);
+    return fourierEngine_->priceStrikes(model, resolved.getSpot(), resolved.getRate(),
+                                        resolved.getTimeToMaturity(), strikes, resolved.getOptionType(),
+                                        resolved.getDividendYield());
+}
+
+std::vector<double> OptionsPricingEngine::priceSpotGrid(const Option& option, const std::vector<double>& spots) {
+    return priceSpotGrid(option, spots, defaultConfig_);
+}
+
+std::vector<double> OptionsPricingEngine::priceSpotGrid(const Option& option, const std::vector<double>& spots,
+                                                        const PricingConfig& config) {
+    std::vector<double> prices(spots.size());
+    binomialEngine_->priceSpots(option, spots.data(), spots.size(), prices.data(), config);
+    return prices;
+}
+
 void OptionsPricingEngine::setBinomialSteps(int steps) {
-    binomialEngine_->setSteps(steps);
+    defaultConfig_.binomialSteps = steps;
 }
 
 void OptionsPricingEngine::setMonteCarloSimulations(int simulations) {
-    monteCarloEngine_->setNumSimulations(simulations);
+    defaultConfig_.monteCarloSimulations = simulations;
 }
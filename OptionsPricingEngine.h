@@ -6,28 +6,129 @@
 #include "BlackScholesEngine.h"
 #include "BinomialEngine.h"
 #include "MonteCarloEngine.h"
+#include "FourierEngine.h"
+#include "ThreadPool.h"
+#include "PricingCache.h"
+#include "SingleFlight.h"
+#include "PricingTypes.h"
+#include "OptionChain.h"
+#include "VolatilitySurface.h"
+#include "TermStructure.h"
+#include "AmericanPriceTable.h"
 #include <memory>
 #include <map>
 #include <functional>
+#include <atomic>
+#include <chrono>
 
 class OptionsPricingEngine {
 public:
     OptionsPricingEngine();
     
+    // Overloads without a PricingConfig use the engine's default configuration
     double price(const Option& option, const std::string& method = "BlackScholes");
+    double price(const Option& option, const std::string& method, const PricingConfig& config);
     std::map<std::string, double> priceAllMethods(const Option& option);
+    
+    // Runs every method concurrently on the engine's thread pool. Methods still running
+    // when the deadline expires report NaN and are listed in timedOut. A task that
+    // only reaches a worker after its deadline is skipped rather than run, and a
+    // method that already has the maximum number of tasks outstanding (abandoned
+    // ones included) is shed without queueing; both are reported the same way.
+    std::map<std::string, double> priceAllMethods(const Option& option, std::chrono::milliseconds deadline,
+                                                  std::vector<std::string>* timedOut = nullptr);
+    std::map<std::string, double> priceAllMethods(const Option& option, const PricingConfig& config,
+                                                  std::chrono::milliseconds deadline,
+                                                  std::vector<std::string>* timedOut = nullptr);
+    
+    // Prices only the requested methods; failures report NaN as in priceAllMethods
+    std::map<std::string, double> priceMethods(const Option& option, const std::vector<std::string>& methods);
+    std::map<std::string, double> priceMethods(const Option& option, const std::vector<std::string>& methods,
+                                               const PricingConfig& config);
     std::map<std::string, double> calculateGreeks(const Option& option);
     
+    // Allocation-free hot path: enum dispatch straight to the engines, results written
+    // into caller-owned structs. Bypasses the result cache and the thread pool.
+    // Methods that do not support the option's exercise type report NaN.
+    double price(const Option& option, PricingMethod method);
+    double price(const Option& option, PricingMethod method, const PricingConfig& config);
+    void priceAllMethods(const Option& option, MethodPrices& out);
+    void calculateGreeks(const Option& option, Greeks& out);
+    
+    // Batch pricing of a finalized chain, one price per leg in chain order
+    void priceChain(const OptionChain& chain, PricingMethod method, std::vector<double>& out);
+    void priceChain(const OptionChain& chain, PricingMethod method, const PricingConfig& config,
+                    std::vector<double>& out);
+    
+    // Prices the option's type/maturity across a whole strike vector in one Fourier pass.
+    // Rates and dividends come from the default term structure when set; with a
+    // volatility surface the default model takes one volatility, the surface's at
+    // the option's own strike, for the whole grid.
+    std::vector<double> priceStrikeGrid(const Option& option, const std::vector<double>& strikes);
+    std::vector<double> priceStrikeGrid(const CharacteristicFunction& model, const Option& option,
+                                        const std::vector<double>& strikes);
+    
+    // Binomial prices of the option at every spot, from one extended tree
+    std::vector<double> priceSpotGrid(const Option& option, const std::vector<double>& spots);
+    std::vector<double> priceSpotGrid(const Option& option, const std::vector<double>& spots,
+                                      const PricingConfig& config);
+    
+    // Defaults are meant to be set up before the engine is shared between threads;
+    // per-request settings should be passed as a PricingConfig instead
     void setBinomialSteps(int steps);
     void setMonteCarloSimulations(int simulations);
+    void setDefaultConfig(const PricingConfig& config) { defaultConfig_ = config; }
+    const PricingConfig& getDefaultConfig() const { return defaultConfig_; }
+    void setVolatilitySurface(std::shared_ptr<const VolatilitySurface> surface) {
+        defaultConfig_.volatilitySurface = surface;
+    }
+    void setTermStructure(std::shared_ptr<const TermStructure> termStructure) {
+        defaultConfig_.termStructure = termStructure;
+    }
+    // Consulted only by configs with useAmericanPriceTables set
+    void setAmericanPriceTables(std::shared_ptr<const AmericanPriceTable> calls,
+                                std::shared_ptr<const AmericanPriceTable> puts);
+    void setMethodDeadline(std::chrono::milliseconds deadline) { methodDeadline_ = deadline; }
+    std::chrono::milliseconds getMethodDeadline() const { return methodDeadline_; }
+    void setMaxOutstandingPerMethod(int maxOutstanding) { maxOutstandingPerMethod_ = maxOutstanding; }
+    int getMaxOutstandingPerMethod() const { return maxOutstandingPerMethod_; }
+    
+    PricingCache::Stats getCacheStats() const { return cache_.getStats(); }
+    void clearCache() { cache_.clear(); }
+    uint64_t getCoalescedCount() const { return inFlight_.getCoalescedCount(); }
+    uint64_t getShedCount() const { return shed_.load(); }
+    uint64_t getSkippedCount() const { return skipped_.load(); }
 
 private:
     std::unique_ptr<BlackScholesEngine> blackScholesEngine_;
     std::unique_ptr<BinomialEngine> binomialEngine_;
     std::unique_ptr<MonteCarloEngine> monteCarloEngine_;
+    std::unique_ptr<FourierEngine> fourierEngine_;
     
     // Use function pointers instead of storing unique_ptr references
-    std::map<std::string, std::function<double(const Option&)>> pricingFunctions_;
+    std::map<std::string, std::function<double(const Option&, const PricingConfig&)>> pricingFunctions_;
+    PricingConfig defaultConfig_;
+    std::chrono::milliseconds methodDeadline_;
+    int maxOutstandingPerMethod_;
+    
+    // Queued or running pool tasks per method; the map itself is fixed after construction
+    std::map<std::string, std::unique_ptr<std::atomic<int>>> outstanding_;
+    std::atomic<uint64_t> shed_;
+    std::atomic<uint64_t> skipped_;
+    PricingCache cache_;
+    SingleFlight<PricingKey, double, PricingKeyHash> inFlight_;
+    
+    // Declared last so it is destroyed first: workers finish any timed-out
+    // tasks before the engines they reference go away
+    ThreadPool pool_;
+    
+    const PricingEngine& engineFor(PricingMethod method) const;
+    double priceCached(const Option& option, const std::string& method, const PricingConfig& config);
+    PricingKey makeCacheKey(const Option& option, const std::string& method, const PricingConfig& config) const;
+    
+    std::map<std::string, double> priceConcurrently(const Option& option, const std::vector<std::string>& methods,
+                                                    const PricingConfig& config, std::chrono::milliseconds deadline,
+                                                    std::vector<std::string>* timedOut);
 };
 
 #endif
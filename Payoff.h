@@ -0,0 +1,27 @@
+// Payoff.h
+#ifndef PAYOFF_H
+#define PAYOFF_H
+
+#include "Option.h"
+#include <algorithm>
+
+// Compile-time payoff functors. Kernels templated on these carry no per-node
+// branch on the option type, unlike Option::payoff.
+template <OptionType Type>
+struct VanillaPayoff;
+
+template <>
+struct VanillaPayoff<OptionType::CALL> {
+    explicit VanillaPayoff(double strike) : strike_(strike) {}
+    double operator()(double spot) const { return std::max(spot - strike_, 0.0); }
+    double strike_;
+};
+
+template <>
+struct VanillaPayoff<OptionType::PUT> {
+    explicit VanillaPayoff(double strike) : strike_(strike) {}
+    double operator()(double spot) const { return std::max(strike_ - spot, 0.0); }
+    double strike_;
+};
+
+#endif
@@ -0,0 +1,229 @@
+#include "PayoffProfile.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+
+PayoffProfile::PayoffProfile(const OptionStrategy& strategy, double stockQuantity, double stockEntryPrice)
+    : intercept_(-stockQuantity * stockEntryPrice), slope_(stockQuantity) {
+    std::vector<PayoffLeg> legs;
+    legs.reserve(strategy.legs.size());
+    for (const auto& leg : strategy.legs) {
+        double sign = (leg.position == PositionType::LONG) ? 1.0 : -1.0;
+        PayoffLeg payoffLeg = { leg.option.getOptionType(), leg.option.getStrike(), sign * leg.quantity, leg.premium };
+        legs.push_back(payoffLeg);
+    }
+    build(legs);
+}
+
+PayoffProfile::PayoffProfile(const std::vector<PayoffLeg>& legs, double stockQuantity, double stockEntryPrice)
+    : intercept_(-stockQuantity * stockEntryPrice), slope_(stockQuantity) {
+    build(legs);
+}
+
+void PayoffProfile::build(const std::vector<PayoffLeg>& legs) {
+    // Net call weight per strike, merged so equal strikes form a single kink
+    std::map<double, double> callWeights;
+    for (const auto& leg : legs) {
+        intercept_ -= leg.quantity * leg.premium;
+        callWeights[leg.strike] += leg.quantity;
+        if (leg.type == OptionType::PUT) {
+            intercept_ += leg.quantity * leg.strike;
+            slope_ -= leg.quantity;
+        }
+    }
+    
+    for (auto it = callWeights.begin(); it != callWeights.end(); ++it) {
+        if (it->second != 0.0) {
+            strikes_.push_back(it->first);
+            weights_.push_back(it->second);
+        }
+    }
+}
+
+double PayoffProfile::evaluate(double spot) const {
+    double pnl = intercept_ + slope_ * spot;
+    for (size_t k = 0; k < strikes_.size(); ++k) {
+        pnl += weights_[k] * std::max(spot - strikes_[k], 0.0);
+    }
+    return pnl;
+}
+
+void PayoffProfile::evaluate(const double* spots, size_t count, double* pnl) const {
+    // Fixed-size local blocks: no aliasing with the caller's arrays and a trip
+    // count the compiler can vectorize without a scalar epilogue
+    const size_t BLOCK = 256;
+    alignas(64) double blockSpots[BLOCK];
+    alignas(64) double blockPnL[BLOCK];
+    
+    for (size_t begin = 0; begin < count; begin += BLOCK) {
+        size_t n = std::min(BLOCK, count - begin);
+        for (size_t i = 0; i < BLOCK; ++i) {
+            blockSpots[i] = spots[begin + std::min(i, n - 1)];
+        }
+        for (size_t i = 0; i < BLOCK; ++i) {
+            blockPnL[i] = intercept_ + slope_ * blockSpots[i];
+        }
+        
+        // Strike-outer so the inner loop is a straight max/multiply-add over contiguous spots
+        for (size_t k = 0; k < strikes_.size(); ++k) {
+            const double strike = strikes_[k];
+            const double weight = weights_[k];
+            for (size_t i = 0; i < BLOCK; ++i) {
+                blockPnL[i] += weight * std::max(blockSpots[i] - strike, 0.0);
+            }
+        }
+        std::copy(blockPnL, blockPnL + n, pnl + begin);
+    }
+}
+
+std::vector<double> PayoffProfile::evaluate(const std::vector<double>& spots) const {
+    std::vector<double> pnl(spots.size());
+    evaluate(spots.data(), spots.size(), pnl.data());
+    return pnl;
+}
+
+double PayoffProfile::terminalSlope() const {
+    double slope = slope_;
+    for (size_t k = 0; k < weights_.size(); ++k) {
+        slope += weights_[k];
+    }
+    return slope;
+}
+
+std::vector<double> PayoffProfile::kinkValues() const {
+    std::vector<double> values(strikes_.size() + 1);
+    values[0] = intercept_;
+    
+    // Walk the kinks accumulating the slope, one segment at a time
+    double slope = slope_;
+    double previous = 0.0;
+    for (size_t k = 0; k < strikes_.size(); ++k) {
+        values[k + 1] = values[k] + slope * (strikes_[k] - previous);
+        slope += weights_[k];
+        previous = strikes_[k];
+    }
+    return values;
+}
+
+std::vector<double> PayoffProfile::breakevens() const {
+    std::vector<double> values = kinkValues();
+    std::vector<double> points;
+    points.reserve(strikes_.size() + 2);
+    points.push_back(0.0);
+    points.insert(points.end(), strikes_.begin(), strikes_.end());
+    
+    // Beyond the last kink the P&L is linear with the terminal slope; one more
+    // point on that line, past any root it has, lets the walk below treat it
+    // like any other segment
+    double slope = terminalSlope();
+    double distance = (slope != 0.0) ? 1.0 + std::fabs(values.back() / slope) : 1.0;
+    points.push_back(points.back() + distance);
+    values.push_back(values.back() + slope * distance);
+    
+    // A root is recorded only where the sign actually flips: a P&L that touches
+    // zero at a kink and turns back is not a breakeven. A run of zeros between
+    // opposite signs breaks even where the run starts.
+    std::vector<double> roots;
+    int sign = 0;  // sign of the last non-zero value
+    bool atZero = false;
+    double zeroStart = 0.0;
+    for (size_t k = 0; k < points.size(); ++k) {
+        if (values[k] == 0.0) {
+            if (!atZero) {
+                atZero = true;
+                zeroStart = points[k];
+            }
+            continue;
+        }
+        int next = (values[k] > 0.0) ? 1 : -1;
+        if (sign != 0 && next != sign) {
+            if (atZero) {
+                roots.push_back(zeroStart);
+            } else {
+                double left = values[k - 1], right = values[k];
+                roots.push_back(points[k - 1] + left * (points[k] - points[k - 1]) / (left - right));
+            }
+        }
+        atZero = false;
+        sign = next;
+    }
+    return roots;
+}
+
+double PayoffProfile::maxProfit() const {
+    if (terminalSlope() > 0.0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    std::vector<double> values = kinkValues();
+    return *std::max_element(values.begin(), values.end());
+}
+
+double PayoffProfile::maxLoss() const {
+    if (terminalSlope() < 0.0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    std::vector<double> values = kinkValues();
+    return std::max(-*std::min_element(values.begin(), values.end()), 0.0);
+}
+
+double PayoffProfile::expectedValue(const TerminalDistribution& law) const {
+    double value = intercept_ + slope_ * law.getForward();
+    for (size_t k = 0; k < strikes_.size(); ++k) {
+        value += weights_[k] * law.expectedCall(strikes_[k]);
+    }
+    return value;
+}
+
+double PayoffProfile::probabilityOfProfit(const TerminalDistribution& law) const {
+    return 1.0 - cumulativeProbability(law, kinkValues(), 0.0);
+}
+
+std::vector<double> PayoffProfile::cumulativeProbabilities(const TerminalDistribution& law,
+                                                           const std::vector<double>& levels) const {
+    std::vector<double> values = kinkValues();
+    std::vector<double> probabilities(levels.size());
+    for (size_t i = 0; i < levels.size(); ++i) {
+        probabilities[i] = cumulativeProbability(law, values, levels[i]);
+    }
+    return probabilities;
+}
+
+double PayoffProfile::cumulativeProbability(const TerminalDistribution& law, const std::vector<double>& values,
+                                            double level) const {
+    const double infinity = std::numeric_limits<double>::infinity();
+    double probability = 0.0;
+    
+    // Segments between kinks: the part where the P&L is at or below the level is
+    // one sub-interval, cut where the line crosses the level
+    double left = 0.0;
+    for (size_t k = 0; k < strikes_.size(); ++k) {
+        double right = strikes_[k];
+        double leftValue = values[k], rightValue = values[k + 1];
+        if (leftValue <= level && rightValue <= level) {
+            probability += law.probabilityBetween(left, right);
+        } else if (leftValue <= level || rightValue <= level) {
+            double cross = left + (level - leftValue) * (right - left) / (rightValue - leftValue);
+            probability += (leftValue <= level) ? law.probabilityBetween(left, cross)
+                                                : law.probabilityBetween(cross, right);
+        }
+        left = right;
+    }
+    
+    // Beyond the last kink the P&L is linear with the terminal slope
+    double leftValue = values.back();
+    double slope = terminalSlope();
+    if (slope == 0.0) {
+        if (leftValue <= level) {
+            probability += law.probabilityBetween(left, infinity);
+        }
+    } else {
+        double cross = left + (level - leftValue) / slope;
+        if (slope > 0.0 && leftValue <= level) {
+            probability += law.probabilityBetween(left, cross);
+        } else if (slope < 0.0) {
+            probability += law.probabilityBetween(leftValue <= level ? left : cross, infinity);
+        }
+    }
+    return std::min(probability, 1.0);
+}
@@ -0,0 +1,69 @@
+// PayoffProfile.h
+#ifndef PAYOFF_PROFILE_H
+#define PAYOFF_PROFILE_H
+
+#include "Option.h"
+#include "AlignedAllocator.h"
+#include "TerminalDistribution.h"
+#include <vector>
+
+// One option leg of a position: signed quantity, positive when long, and the
+// premium paid or received per unit
+struct PayoffLeg {
+    OptionType type;
+    double strike;
+    double quantity;
+    double premium;
+};
+
+// Expiry P&L of a multi-leg position, flattened for evaluation over spot grids.
+// Puts are rewritten as calls through parity, max(K - S, 0) = max(S - K, 0) - (S - K),
+// so the whole position is
+//   P&L(S) = intercept + slope * S + sum_k weight_k * max(S - K_k, 0)
+// with one weight per distinct strike. The grid kernel is then a branch-free
+// multiply-add per (strike, spot), and breakevens and extremes follow exactly
+// from the kinks.
+class PayoffProfile {
+public:
+    // Optionally with a stock position of stockQuantity shares bought at stockEntryPrice
+    explicit PayoffProfile(const OptionStrategy& strategy, double stockQuantity = 0.0, double stockEntryPrice = 0.0);
+    explicit PayoffProfile(const std::vector<PayoffLeg>& legs, double stockQuantity = 0.0, double stockEntryPrice = 0.0);
+    
+    double evaluate(double spot) const;
+    void evaluate(const double* spots, size_t count, double* pnl) const;
+    std::vector<double> evaluate(const std::vector<double>& spots) const;
+    
+    // Spots in (0, inf) where the P&L changes sign, ascending
+    std::vector<double> breakevens() const;
+    
+    // Over spots in [0, inf); infinity when the P&L is unbounded above
+    double maxProfit() const;
+    // Positive size of the worst loss (0 if the position cannot lose); infinity when unbounded
+    double maxLoss() const;
+    
+    // Under a terminal law of the spot, integrated in closed form one linear
+    // segment at a time between the kinks
+    double expectedValue(const TerminalDistribution& law) const;
+    double probabilityOfProfit(const TerminalDistribution& law) const;
+    // P(P&L <= level) for each level
+    std::vector<double> cumulativeProbabilities(const TerminalDistribution& law,
+                                                const std::vector<double>& levels) const;
+    
+    const AlignedVector<double>& getStrikes() const { return strikes_; }
+
+private:
+    double intercept_;
+    double slope_;
+    AlignedVector<double> strikes_;  // ascending, distinct
+    AlignedVector<double> weights_;
+    
+    void build(const std::vector<PayoffLeg>& legs);
+    double terminalSlope() const;
+    
+    // P&L at 0 and at every kink, in order
+    std::vector<double> kinkValues() const;
+    double cumulativeProbability(const TerminalDistribution& law, const std::vector<double>& values,
+                                 double level) const;
+};
+
+#endif
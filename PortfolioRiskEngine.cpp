@@ -0,0 +1,89 @@
+#include "PortfolioRiskEngine.h"
+#include <algorithm>
+#include <stdexcept>
+
+RiskTotals& RiskTotals::operator+=(const RiskTotals& other) {
+    value += other.value;
+    delta += other.delta;
+    gamma += other.gamma;
+    vega += other.vega;
+    theta += other.theta;
+    return *this;
+}
+
+RiskTotals& RiskTotals::operator-=(const RiskTotals& other) {
+    value -= other.value;
+    delta -= other.delta;
+    gamma -= other.gamma;
+    vega -= other.vega;
+    theta -= other.theta;
+    return *this;
+}
+
+ExpiryBuckets::ExpiryBuckets(const std::vector<double>& edges) : edges_(edges) {
+    std::sort(edges_.begin(), edges_.end());
+}
+
+std::vector<double> ExpiryBuckets::defaultEdges() {
+    // 1M, 3M, 6M, 1Y, 2Y, 5Y
+    double edges[] = { 1.0 / 12.0, 0.25, 0.5, 1.0, 2.0, 5.0 };
+    return std::vector<double>(edges, edges + sizeof(edges) / sizeof(edges[0]));
+}
+
+size_t ExpiryBuckets::bucketFor(double timeToMaturity) const {
+    return std::lower_bound(edges_.begin(), edges_.end(), timeToMaturity) - edges_.begin();
+}
+
+PortfolioRiskEngine::PortfolioRiskEngine(const ExpiryBuckets& buckets, ThreadPool& pool)
+    : buckets_(buckets), pool_(pool) {}
+
+PortfolioRisk PortfolioRiskEngine::aggregate(const OptionChain& book) {
+    if (!book.isFinalized()) {
+        throw std::logic_error("OptionChain must be finalized before aggregation");
+    }
+    
+    // Work items are sub-ranges of single expiry groups
+    struct Chunk {
+        size_t group, begin, end;
+    };
+    std::vector<Chunk> chunks;
+    const std::vector<OptionChain::ExpiryGroup>& groups = book.getExpiryGroups();
+    for (size_t g = 0; g < groups.size(); ++g) {
+        for (size_t begin = groups[g].begin; begin < groups[g].end; begin += CHUNK_SIZE) {
+            Chunk chunk = { g, begin, std::min(groups[g].end, begin + CHUNK_SIZE) };
+            chunks.push_back(chunk);
+        }
+    }
+    
+    std::vector<RiskTotals> partials(chunks.size());
+    pool_.parallelFor(chunks.size(), 1, [this, &book, &chunks, &partials](size_t first, size_t last) {
+        for (size_t c = first; c < last; ++c) {
+            double value = 0.0;
+            Greeks greeks = Greeks();
+            blackScholesEngine_.accumulateGreeks(book, chunks[c].group, chunks[c].begin, chunks[c].end,
+                                                 value, greeks);
+            partials[c].value = value;
+            partials[c].delta = greeks.delta;
+            partials[c].gamma = greeks.gamma;
+            partials[c].vega = greeks.vega;
+            partials[c].theta = greeks.theta;
+        }
+    });
+    
+    PortfolioRisk risk;
+    risk.numBuckets = buckets_.size();
+    risk.byUnderlying.resize(book.getUnderlyings().size());
+    risk.byExpiryBucket.resize(risk.numBuckets);
+    risk.byUnderlyingAndBucket.resize(book.getUnderlyings().size() * risk.numBuckets);
+    
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        const OptionChain::ExpiryGroup& group = groups[chunks[c].group];
+        size_t bucket = buckets_.bucketFor(group.timeToMaturity);
+        risk.total += partials[c];
+        risk.byUnderlying[group.underlying] += partials[c];
+        risk.byExpiryBucket[bucket] += partials[c];
+        risk.byUnderlyingAndBucket[group.underlying * risk.numBuckets + bucket] += partials[c];
+    }
+    
+    return risk;
+}
@@ -0,0 +1,66 @@
+// PortfolioRiskEngine.h
+#ifndef PORTFOLIO_RISK_ENGINE_H
+#define PORTFOLIO_RISK_ENGINE_H
+
+#include "OptionChain.h"
+#include "BlackScholesEngine.h"
+#include "ThreadPool.h"
+#include <vector>
+
+struct RiskTotals {
+    double value, delta, gamma, vega, theta;
+    
+    RiskTotals() : value(0.0), delta(0.0), gamma(0.0), vega(0.0), theta(0.0) {}
+    RiskTotals& operator+=(const RiskTotals& other);
+    RiskTotals& operator-=(const RiskTotals& other);
+};
+
+struct PortfolioRisk {
+    RiskTotals total;
+    std::vector<RiskTotals> byUnderlying;
+    std::vector<RiskTotals> byExpiryBucket;
+    std::vector<RiskTotals> byUnderlyingAndBucket;  // [underlying * numBuckets + bucket]
+    size_t numBuckets;
+    
+    const RiskTotals& cell(size_t underlying, size_t bucket) const {
+        return byUnderlyingAndBucket[underlying * numBuckets + bucket];
+    }
+};
+
+// Maturity buckets for risk reports: bucket i holds expiries in (edges[i-1], edges[i]],
+// the last bucket is open-ended
+class ExpiryBuckets {
+public:
+    ExpiryBuckets(const std::vector<double>& edges = defaultEdges());
+    
+    size_t bucketFor(double timeToMaturity) const;
+    size_t size() const { return edges_.size() + 1; }
+    
+    static std::vector<double> defaultEdges();
+
+private:
+    std::vector<double> edges_;
+};
+
+// Book-level Black-Scholes revaluation and risk. Expiry groups of a finalized
+// OptionChain are split into chunks that run on a persistent pool; each chunk
+// belongs to exactly one (underlying, expiry bucket) cell, so the reduction is
+// a sum over per-chunk partials.
+class PortfolioRiskEngine {
+public:
+    PortfolioRiskEngine(const ExpiryBuckets& buckets = ExpiryBuckets(),
+                        ThreadPool& pool = ThreadPool::shared());
+    
+    PortfolioRisk aggregate(const OptionChain& book);
+    
+    const ExpiryBuckets& getBuckets() const { return buckets_; }
+
+private:
+    ExpiryBuckets buckets_;
+    BlackScholesEngine blackScholesEngine_;
+    ThreadPool& pool_;
+    
+    static const size_t CHUNK_SIZE = 16384;
+};
+
+#endif
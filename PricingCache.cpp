@@ -0,0 +1,142 @@
+#include "PricingCache.h"
+#include <cstring>
+
+namespace {
+double normalize(double value) {
+    // Collapse -0.0 onto 0.0 so both hash and compare identically
+    return value == 0.0 ? 0.0 : value;
+}
+
+uint64_t bitsOf(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+void hashCombine(uint64_t& seed, uint64_t value) {
+    seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+}
+
+PricingKey::PricingKey(const Option& option, const std::string& pricingMethod, int binomialSteps,
+                       int monteCarloSimulations, unsigned int monteCarloSeed, int monteCarloScheme)
+    : spot(normalize(option.getSpot())), strike(normalize(option.getStrike())),
+      rate(normalize(option.getRate())), volatility(normalize(option.getVolatility())),
+      timeToMaturity(normalize(option.getTimeToMaturity())), dividendYield(normalize(option.getDividendYield())),
+      optionType(option.getOptionType()), exerciseType(option.getExerciseType()),
+      method(pricingMethod), steps(binomialSteps), simulations(monteCarloSimulations),
+      seed(monteCarloSeed), scheme(monteCarloScheme) {}
+
+bool PricingKey::operator==(const PricingKey& other) const {
+    return spot == other.spot && strike == other.strike && rate == other.rate &&
+           volatility == other.volatility && timeToMaturity == other.timeToMaturity &&
+           dividendYield == other.dividendYield &&
+           optionType == other.optionType && exerciseType == other.exerciseType &&
+           steps == other.steps && simulations == other.simulations && seed == other.seed &&
+           scheme == other.scheme &&
+           method == other.method;
+}
+
+size_t PricingKeyHash::operator()(const PricingKey& key) const {
+    uint64_t seed = std::hash<std::string>()(key.method);
+    hashCombine(seed, bitsOf(key.spot));
+    hashCombine(seed, bitsOf(key.strike));
+    hashCombine(seed, bitsOf(key.rate));
+    hashCombine(seed, bitsOf(key.volatility));
+    hashCombine(seed, bitsOf(key.timeToMaturity));
+    hashCombine(seed, bitsOf(key.dividendYield));
+    hashCombine(seed, static_cast<uint64_t>(key.optionType) << 1 | static_cast<uint64_t>(key.exerciseType));
+    hashCombine(seed, static_cast<uint64_t>(key.steps));
+    hashCombine(seed, static_cast<uint64_t>(key.simulations));
+    hashCombine(seed, key.seed);
+    hashCombine(seed, static_cast<uint64_t>(key.scheme));
+    return static_cast<size_t>(seed);
+}
+
+PricingCache::PricingCache(size_t maxBytes, size_t numShards)
+    : shards_(numShards > 0 ? numShards : 1), shardBudget_(maxBytes / shards_.size()),
+      hits_(0), misses_(0), evictions_(0) {}
+
+PricingCache::Shard& PricingCache::shardFor(const PricingKey& key) {
+    // Use the high bits for shard selection; the low bits index the shard's hash table
+    size_t hash = PricingKeyHash()(key);
+    return shards_[((hash >> (sizeof(size_t) * 4)) ^ hash) % shards_.size()];
+}
+
+size_t PricingCache::entrySize(const PricingKey& key) {
+    // List node, hash-table node with bucket pointer, and any heap-allocated method name
+    size_t methodHeap = key.method.capacity() > 15 ? key.method.capacity() + 1 : 0;
+    return sizeof(std::pair<PricingKey, Entry>) + 2 * sizeof(void*) +
+           sizeof(PricingKey) + sizeof(LruList::iterator) + 2 * sizeof(void*) +
+           2 * methodHeap;
+}
+
+bool PricingCache::lookup(const PricingKey& key, Entry& entry) {
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    
+    auto it = shard.index.find(key);
+    if (it == shard.index.end()) {
+        ++misses_;
+        return false;
+    }
+    
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    entry = it->second->second;
+    ++hits_;
+    return true;
+}
+
+void PricingCache::insert(const PricingKey& key, const Entry& entry) {
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    
+    auto it = shard.index.find(key);
+    if (it != shard.index.end()) {
+        it->second->second = entry;
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        return;
+    }
+    
+    size_t size = entrySize(key);
+    if (size > shardBudget_) {
+        return;
+    }
+    
+    while (shard.bytes + size > shardBudget_ && !shard.lru.empty()) {
+        const PricingKey& victim = shard.lru.back().first;
+        shard.bytes -= entrySize(victim);
+        shard.index.erase(victim);
+        shard.lru.pop_back();
+        ++evictions_;
+    }
+    
+    shard.lru.emplace_front(key, entry);
+    shard.index.emplace(key, shard.lru.begin());
+    shard.bytes += size;
+}
+
+void PricingCache::clear() {
+    for (auto it = shards_.begin(); it != shards_.end(); ++it) {
+        std::lock_guard<std::mutex> lock(it->mutex);
+        it->index.clear();
+        it->lru.clear();
+        it->bytes = 0;
+    }
+}
+
+PricingCache::Stats PricingCache::getStats() const {
+    Stats stats;
+    stats.hits = hits_.load();
+    stats.misses = misses_.load();
+    stats.evictions = evictions_.load();
+    stats.entries = 0;
+    stats.bytes = 0;
+    
+    for (auto it = shards_.begin(); it != shards_.end(); ++it) {
+        std::lock_guard<std::mutex> lock(it->mutex);
+        stats.entries += it->lru.size();
+        stats.bytes += it->bytes;
+    }
+    return stats;
+}
@@ -0,0 +1,79 @@
+// PricingCache.h
+#ifndef PRICING_CACHE_H
+#define PRICING_CACHE_H
+
+#include "Option.h"
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Normalized pricing request. Parameters that do not influence the chosen method
+// (tree steps for Monte Carlo, simulations for the tree, ...) are zeroed by the
+// caller so equivalent requests share an entry.
+struct PricingKey {
+    double spot, strike, rate, volatility, timeToMaturity, dividendYield;
+    OptionType optionType;
+    ExerciseType exerciseType;
+    std::string method;
+    int steps;
+    int simulations;
+    unsigned int seed;
+    int scheme;
+    
+    PricingKey(const Option& option, const std::string& pricingMethod, int binomialSteps = 0,
+               int monteCarloSimulations = 0, unsigned int monteCarloSeed = 0, int monteCarloScheme = 0);
+    
+    bool operator==(const PricingKey& other) const;
+};
+
+struct PricingKeyHash {
+    size_t operator()(const PricingKey& key) const;
+};
+
+// Concurrent LRU cache of prices, split into independently locked shards and
+// bounded by an approximate memory budget.
+class PricingCache {
+public:
+    struct Entry {
+        double price;
+        unsigned int seed;  // Monte Carlo seed the price was produced with, 0 otherwise
+    };
+    
+    struct Stats {
+        uint64_t hits, misses, evictions;
+        size_t entries, bytes;
+    };
+    
+    PricingCache(size_t maxBytes = 16 * 1024 * 1024, size_t numShards = 16);
+    
+    bool lookup(const PricingKey& key, Entry& entry);
+    void insert(const PricingKey& key, const Entry& entry);
+    void clear();
+    
+    Stats getStats() const;
+
+private:
+    typedef std::list<std::pair<PricingKey, Entry>> LruList;
+    
+    struct Shard {
+        mutable std::mutex mutex;
+        LruList lru;  // most recently used at the front
+        std::unordered_map<PricingKey, LruList::iterator, PricingKeyHash> index;
+        size_t bytes = 0;
+    };
+    
+    std::vector<Shard> shards_;
+    size_t shardBudget_;
+    std::atomic<uint64_t> hits_;
+    std::atomic<uint64_t> misses_;
+    std::atomic<uint64_t> evictions_;
+    
+    Shard& shardFor(const PricingKey& key);
+    static size_t entrySize(const PricingKey& key);
+};
+
+#endif
@@ -0,0 +1,31 @@
+#include "PricingEngine.h"
+#include "OptionChain.h"
+#include "VolatilitySurface.h"
+#include "TermStructure.h"
+#include <limits>
+#include <stdexcept>
+
+void PricingEngine::priceChain(const OptionChain& chain, const PricingConfig& config, std::vector<double>& out) const {
+    if (!chain.isFinalized()) {
+        throw std::logic_error("OptionChain must be finalized before pricing");
+    }
+    
+    // Chain legs already carry their underlying's term structure
+    PricingConfig legConfig = config;
+    legConfig.termStructure.reset();
+    
+    out.resize(chain.size());
+    for (size_t leg = 0; leg < chain.size(); ++leg) {
+        try {
+            out[leg] = price(chain.toOption(leg), legConfig);
+        } catch (const std::exception& e) {
+            out[leg] = std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+}
+
+Option PricingEngine::resolveMarketData(const Option& option, const PricingConfig& config) {
+    // Rates first: surface moneyness is measured against the dividend-adjusted forward
+    Option resolved = config.termStructure ? config.termStructure->applyTo(option) : option;
+    return config.volatilitySurface ? config.volatilitySurface->applyTo(resolved) : resolved;
+}
@@ -3,12 +3,26 @@
 #define PRICING_ENGINE_H
 
 #include "Option.h"
+#include "PricingTypes.h"
+#include <vector>
+
+class OptionChain;
 
 class PricingEngine {
 public:
     virtual ~PricingEngine() = default;
-    virtual double price(const Option& option) = 0;
+    virtual double price(const Option& option, const PricingConfig& config) const = 0;
+    double price(const Option& option) const { return price(option, PricingConfig()); }
     virtual std::string getMethodName() const = 0;
+    
+    // Prices every leg of a finalized chain into out, in chain order. Legs the engine
+    // does not support are NaN. The default prices leg by leg; engines override it
+    // to share per-expiry work across a group.
+    virtual void priceChain(const OptionChain& chain, const PricingConfig& config, std::vector<double>& out) const;
+    
+    // The option as the engines price it: the config's term structure and
+    // volatility surface applied, when it carries them
+    static Option resolveMarketData(const Option& option, const PricingConfig& config);
 };
 
 #endif
@@ -0,0 +1,48 @@
+// PricingTypes.h
+#ifndef PRICING_TYPES_H
+#define PRICING_TYPES_H
+
+#include <memory>
+
+class VolatilitySurface;
+class TermStructure;
+
+enum class MonteCarloScheme { STANDARD, ANTITHETIC, CONTROL_VARIATE };
+
+// Per-call accuracy settings. Engines hold no mutable state of their own, so one
+// instance can serve every thread with a different configuration per request.
+struct PricingConfig {
+    int binomialSteps = 100;
+    int monteCarloSimulations = 100000;
+    unsigned int seed = 42;
+    MonteCarloScheme scheme = MonteCarloScheme::STANDARD;
+    
+    // When set, engines take each option's volatility from the surface at its
+    // strike and maturity instead of Option::getVolatility()
+    std::shared_ptr<const VolatilitySurface> volatilitySurface;
+    
+    // When set, rates and dividends for each option's expiry come from the term
+    // structure instead of the option's flat rate
+    std::shared_ptr<const TermStructure> termStructure;
+    
+    // When set, the binomial engine prices American options inside its
+    // AmericanPriceTable domains from the tables instead of a binomialSteps tree
+    bool useAmericanPriceTables = false;
+};
+
+// Fixed-layout pricing results for the allocation-free API
+enum class PricingMethod { BLACK_SCHOLES, BINOMIAL, MONTE_CARLO, FOURIER };
+
+struct MethodPrices {
+    static const int NUM_METHODS = 4;
+    double values[NUM_METHODS];
+    
+    double& operator[](PricingMethod method) { return values[static_cast<int>(method)]; }
+    double operator[](PricingMethod method) const { return values[static_cast<int>(method)]; }
+};
+
+struct Greeks {
+    double delta, gamma, theta, vega, rho;
+};
+
+#endif
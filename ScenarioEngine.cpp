@@ -0,0 +1,86 @@
+#include "ScenarioEngine.h"
+#include <algorithm>
+#include <stdexcept>
+
+ScenarioGrid ScenarioGrid::symmetric(double maxSpotShock, size_t spotSteps, double maxVolShock, size_t volSteps) {
+    if (spotSteps == 0 || volSteps == 0) {
+        throw std::invalid_argument("Scenario grid needs at least one shock per axis");
+    }
+    
+    ScenarioGrid grid;
+    for (size_t i = 0; i < spotSteps; ++i) {
+        grid.spotShocks.push_back(spotSteps == 1 ? 0.0 : -maxSpotShock + 2.0 * maxSpotShock * i / (spotSteps - 1));
+    }
+    for (size_t j = 0; j < volSteps; ++j) {
+        grid.volShocks.push_back(volSteps == 1 ? 0.0 : -maxVolShock + 2.0 * maxVolShock * j / (volSteps - 1));
+    }
+    return grid;
+}
+
+ScenarioEngine::ScenarioEngine(ThreadPool& pool) : pool_(pool) {}
+
+ScenarioCube ScenarioEngine::run(const OptionChain& book, const ScenarioGrid& grid) {
+    if (!book.isFinalized()) {
+        throw std::logic_error("OptionChain must be finalized before scenario analysis");
+    }
+    if (grid.spotShocks.empty() || grid.volShocks.empty()) {
+        throw std::invalid_argument("Scenario grid needs at least one shock per axis");
+    }
+    for (auto it = grid.spotShocks.begin(); it != grid.spotShocks.end(); ++it) {
+        if (*it <= -1.0) {
+            throw std::invalid_argument("Spot shocks must keep the spot positive");
+        }
+    }
+    
+    struct Chunk {
+        size_t group, begin, end;
+    };
+    std::vector<Chunk> chunks;
+    const std::vector<OptionChain::ExpiryGroup>& groups = book.getExpiryGroups();
+    for (size_t g = 0; g < groups.size(); ++g) {
+        for (size_t begin = groups[g].begin; begin < groups[g].end; begin += CHUNK_SIZE) {
+            Chunk chunk = { g, begin, std::min(groups[g].end, begin + CHUNK_SIZE) };
+            chunks.push_back(chunk);
+        }
+    }
+    
+    // Each chunk writes its own slice of cells; slices are reduced afterwards
+    const size_t numCells = grid.spotShocks.size() * grid.volShocks.size();
+    std::vector<double> partialValues(chunks.size() * numCells, 0.0);
+    std::vector<double> partialBase(chunks.size(), 0.0);
+    pool_.parallelFor(chunks.size(), 1, [&](size_t first, size_t last) {
+        for (size_t c = first; c < last; ++c) {
+            blackScholesEngine_.accumulateScenarios(book, chunks[c].group, chunks[c].begin, chunks[c].end,
+                                                    grid.spotShocks, grid.volShocks,
+                                                    partialBase[c], &partialValues[c * numCells]);
+        }
+    });
+    
+    ScenarioCube cube;
+    cube.numUnderlyings = book.getUnderlyings().size();
+    cube.numSpotShocks = grid.spotShocks.size();
+    cube.numVolShocks = grid.volShocks.size();
+    cube.baseValue.assign(cube.numUnderlyings, 0.0);
+    cube.pnl.assign(cube.numUnderlyings * numCells, 0.0);
+    cube.totalPnl.assign(numCells, 0.0);
+    
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        size_t u = groups[chunks[c].group].underlying;
+        cube.baseValue[u] += partialBase[c];
+        double* slice = &cube.pnl[u * numCells];
+        const double* values = &partialValues[c * numCells];
+        for (size_t cell = 0; cell < numCells; ++cell) {
+            slice[cell] += values[cell];
+        }
+    }
+    
+    for (size_t u = 0; u < cube.numUnderlyings; ++u) {
+        double* slice = &cube.pnl[u * numCells];
+        for (size_t cell = 0; cell < numCells; ++cell) {
+            slice[cell] -= cube.baseValue[u];
+            cube.totalPnl[cell] += slice[cell];
+        }
+    }
+    
+    return cube;
+}
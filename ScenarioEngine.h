@@ -0,0 +1,52 @@
+// ScenarioEngine.h
+#ifndef SCENARIO_ENGINE_H
+#define SCENARIO_ENGINE_H
+
+#include "OptionChain.h"
+#include "BlackScholesEngine.h"
+#include "ThreadPool.h"
+#include <vector>
+
+// Spot shocks are relative (0.05 = +5%), vol shocks absolute (0.02 = +2 vol points)
+struct ScenarioGrid {
+    std::vector<double> spotShocks;
+    std::vector<double> volShocks;
+    
+    // Evenly spaced shocks in [-maxShock, +maxShock]
+    static ScenarioGrid symmetric(double maxSpotShock = 0.10, size_t spotSteps = 21,
+                                  double maxVolShock = 0.05, size_t volSteps = 11);
+};
+
+// Dense P&L cube [underlying][spot shock][vol shock] relative to the unshocked book
+struct ScenarioCube {
+    size_t numUnderlyings, numSpotShocks, numVolShocks;
+    std::vector<double> baseValue;   // per underlying
+    std::vector<double> pnl;         // numUnderlyings * numSpotShocks * numVolShocks
+    std::vector<double> totalPnl;    // numSpotShocks * numVolShocks, summed over underlyings
+    
+    double at(size_t underlying, size_t spot, size_t vol) const {
+        return pnl[(underlying * numSpotShocks + spot) * numVolShocks + vol];
+    }
+    double total(size_t spot, size_t vol) const {
+        return totalPnl[spot * numVolShocks + vol];
+    }
+};
+
+// Revalues a finalized OptionChain under every cell of a ScenarioGrid in one pass.
+// Work is split into leg chunks of single expiry groups; each chunk evaluates all
+// cells for its legs so per-leg terms are computed once rather than once per cell.
+// Legs are valued with Black-Scholes, as in PortfolioRiskEngine.
+class ScenarioEngine {
+public:
+    explicit ScenarioEngine(ThreadPool& pool = ThreadPool::shared());
+    
+    ScenarioCube run(const OptionChain& book, const ScenarioGrid& grid);
+
+private:
+    BlackScholesEngine blackScholesEngine_;
+    ThreadPool& pool_;
+    
+    static const size_t CHUNK_SIZE = 4096;
+};
+
+#endif
@@ -0,0 +1,65 @@
+// SingleFlight.h
+#ifndef SINGLE_FLIGHT_H
+#define SINGLE_FLIGHT_H
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <unordered_map>
+
+// Coalesces concurrent computations of the same key: the first caller computes,
+// callers arriving while it is in flight wait on the same shared future. Nothing
+// is retained once the computation completes.
+template <class Key, class Value, class Hash = std::hash<Key>>
+class SingleFlight {
+public:
+    SingleFlight() : coalesced_(0) {}
+    
+    template <class F>
+    Value run(const Key& key, F&& compute) {
+        std::promise<Value> promise;
+        std::shared_future<Value> result;
+        bool leader = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = inFlight_.find(key);
+            if (it != inFlight_.end()) {
+                result = it->second;
+            } else {
+                result = promise.get_future().share();
+                inFlight_.emplace(key, result);
+                leader = true;
+            }
+        }
+        
+        if (!leader) {
+            ++coalesced_;
+            return result.get();  // rethrows the leader's exception
+        }
+        
+        try {
+            promise.set_value(compute());
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            inFlight_.erase(key);
+        }
+        return result.get();
+    }
+    
+    // Number of calls that were served by another caller's computation
+    uint64_t getCoalescedCount() const { return coalesced_.load(); }
+
+private:
+    std::mutex mutex_;
+    std::unordered_map<Key, std::shared_future<Value>, Hash> inFlight_;
+    std::atomic<uint64_t> coalesced_;
+};
+
+#endif
@@ -0,0 +1,309 @@
+#include "StrategyEngine.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <stdexcept>
+
+StrategyEngine::StrategyEngine(OptionsPricingEngine& pricer) : pricer_(pricer) {}
+
+std::vector<double> StrategyEngine::premiums(const StrategySpec& spec, const StrategyMarket& market) {
+    return premiums(spec, market, pricer_.getDefaultConfig());
+}
+
+std::vector<double> StrategyEngine::premiums(const StrategySpec& spec, const StrategyMarket& market,
+                                             const PricingConfig& config) {
+    if (market.spot <= 0.0 || market.volatility <= 0.0) {
+        throw std::invalid_argument("Strategy spot and volatility must be positive");
+    }
+    
+    OptionChain chain = buildChain(spec, market, market.volatility, config);
+    std::vector<double> chainPrices;
+    pricer_.priceChain(chain, PricingMethod::BLACK_SCHOLES, config, chainPrices);
+    
+    // Second chain of just the American legs, in the first chain's order
+    OptionChain americanChain;
+    size_t americanUnderlying = americanChain.addUnderlying("strategy", market.spot, market.rate);
+    americanChain.setTermStructure(americanUnderlying, chain.getUnderlyings()[0].termStructure);
+    std::vector<size_t> positions;
+    for (size_t leg = 0; leg < chain.size(); ++leg) {
+        if (chain.exercises()[leg] == ExerciseType::AMERICAN) {
+            americanChain.addOption(americanUnderlying, chain.strikes()[leg], chain.expiries()[leg],
+                                    chain.volatilities()[leg], chain.types()[leg], ExerciseType::AMERICAN,
+                                    chain.quantities()[leg]);
+            positions.push_back(leg);
+        }
+    }
+    if (!positions.empty()) {
+        americanChain.finalize();
+        std::vector<double> americanPrices;
+        pricer_.priceChain(americanChain, PricingMethod::BINOMIAL, config, americanPrices);
+        for (size_t leg = 0; leg < americanChain.size(); ++leg) {
+            chainPrices[positions[americanChain.legId(leg)]] = americanPrices[leg];
+        }
+    }
+    
+    std::vector<double> prices(spec.legs.size());
+    for (size_t leg = 0; leg < chain.size(); ++leg) {
+        prices[chain.legId(leg)] = chainPrices[leg];
+    }
+    return prices;
+}
+
+StrategyAnalysis StrategyEngine::analyze(const StrategySpec& spec, const StrategyMarket& market,
+                                         const std::vector<double>& spots) {
+    return analyze(spec, market, spots, pricer_.getDefaultConfig());
+}
+
+StrategyAnalysis StrategyEngine::analyze(const StrategySpec& spec, const StrategyMarket& market,
+                                         const std::vector<double>& spots, const PricingConfig& config) {
+    StrategyAnalysis analysis;
+    analysis.premiums = premiums(spec, market, config);
+    
+    analysis.netPremium = 0.0;
+    for (size_t leg = 0; leg < spec.legs.size(); ++leg) {
+        analysis.netPremium -= spec.legs[leg].quantity * analysis.premiums[leg];
+    }
+    
+    PayoffProfile payoff = profile(spec, analysis.premiums);
+    analysis.maxProfit = payoff.maxProfit();
+    analysis.maxLoss = payoff.maxLoss();
+    analysis.breakevens = payoff.breakevens();
+    analysis.pnl = payoff.evaluate(spots);
+    return analysis;
+}
+
+std::vector<HorizonCurve> StrategyEngine::horizonCurves(const StrategySpec& spec, const StrategyMarket& market,
+                                                        const std::vector<double>& premiums,
+                                                        const std::vector<double>& spots,
+                                                        const std::vector<double>& horizons,
+                                                        const std::vector<double>& volatilities) {
+    return horizonCurves(spec, market, premiums, spots, horizons, volatilities, pricer_.getDefaultConfig());
+}
+
+std::vector<HorizonCurve> StrategyEngine::horizonCurves(const StrategySpec& spec, const StrategyMarket& market,
+                                                        const std::vector<double>& premiums,
+                                                        const std::vector<double>& spots,
+                                                        const std::vector<double>& horizons,
+                                                        const std::vector<double>& volatilities,
+                                                        const PricingConfig& config) {
+    if (premiums.size() != spec.legs.size()) {
+        throw std::invalid_argument("Need one premium per strategy leg");
+    }
+    for (size_t h = 0; h < horizons.size(); ++h) {
+        if (horizons[h] < 0.0) {
+            throw std::invalid_argument("Horizons must not be negative");
+        }
+    }
+    for (size_t k = 0; k < spots.size(); ++k) {
+        if (spots[k] <= 0.0) {
+            throw std::invalid_argument("Horizon spots must be positive");
+        }
+    }
+    
+    // Stock P&L and premiums paid are the same for every curve
+    std::vector<double> base(spots.size());
+    double premiumCost = 0.0;
+    for (size_t leg = 0; leg < spec.legs.size(); ++leg) {
+        premiumCost += spec.legs[leg].quantity * premiums[leg];
+    }
+    for (size_t k = 0; k < spots.size(); ++k) {
+        base[k] = spec.stockQuantity * (spots[k] - spec.stockEntryPrice) - premiumCost;
+    }
+    
+    // American legs get one extended tree per curve, at the group's flat rates
+    PricingConfig treeConfig = config;
+    treeConfig.termStructure.reset();
+    treeConfig.volatilitySurface.reset();
+    
+    std::vector<HorizonCurve> curves;
+    curves.reserve(horizons.size() * volatilities.size());
+    for (size_t h = 0; h < horizons.size(); ++h) {
+        for (size_t v = 0; v < volatilities.size(); ++v) {
+            HorizonCurve curve;
+            curve.horizon = horizons[h];
+            curve.volatility = volatilities[v];
+            curve.pnl = base;
+            curves.push_back(curve);
+        }
+    }
+    
+    for (size_t v = 0; v < volatilities.size(); ++v) {
+        if (volatilities[v] <= 0.0) {
+            throw std::invalid_argument("Horizon volatilities must be positive");
+        }
+        OptionChain chain = buildChain(spec, market, volatilities[v], config);
+        const std::vector<OptionChain::ExpiryGroup>& groups = chain.getExpiryGroups();
+        
+        for (size_t h = 0; h < horizons.size(); ++h) {
+            double* pnl = curves[h * volatilities.size() + v].pnl.data();
+            
+            for (size_t g = 0; g < groups.size(); ++g) {
+                const OptionChain::ExpiryGroup& group = groups[g];
+                double remaining = group.timeToMaturity - horizons[h];
+                
+                size_t leg = group.begin;
+                while (leg < group.end) {
+                    if (remaining <= 0.0) {
+                        double phi = (chain.types()[leg] == OptionType::CALL) ? 1.0 : -1.0;
+                        double strike = chain.strikes()[leg];
+                        double quantity = chain.quantities()[leg];
+                        for (size_t k = 0; k < spots.size(); ++k) {
+                            pnl[k] += quantity * std::max(phi * (spots[k] - strike), 0.0);
+                        }
+                        ++leg;
+                    } else if (chain.exercises()[leg] == ExerciseType::AMERICAN) {
+                        Option live(market.spot, chain.strikes()[leg], group.rate, volatilities[v], remaining,
+                                    chain.types()[leg], ExerciseType::AMERICAN, group.dividendYield);
+                        std::vector<double> values = pricer_.priceSpotGrid(live, spots, treeConfig);
+                        for (size_t k = 0; k < spots.size(); ++k) {
+                            pnl[k] += chain.quantities()[leg] * values[k];
+                        }
+                        ++leg;
+                    } else {
+                        // Contiguous European legs share the horizon's discounting and log spots
+                        size_t last = leg;
+                        while (last < group.end && chain.exercises()[last] == ExerciseType::EUROPEAN) {
+                            ++last;
+                        }
+                        blackScholesEngine_.accumulatePathValues(chain, g, leg, last, horizons[h], spots.data(),
+                                                                 spots.size(), pnl);
+                        leg = last;
+                    }
+                }
+            }
+        }
+    }
+    return curves;
+}
+
+StrategyOutcome StrategyEngine::outcome(const StrategySpec& spec, const StrategyMarket& market,
+                                        const std::vector<double>& premiums, const std::vector<double>& levels) {
+    return outcome(spec, market, premiums, levels, pricer_.getDefaultConfig());
+}
+
+StrategyOutcome StrategyEngine::outcome(const StrategySpec& spec, const StrategyMarket& market,
+                                        const std::vector<double>& premiums, const std::vector<double>& levels,
+                                        const PricingConfig& config) {
+    if (spec.legs.empty()) {
+        throw std::invalid_argument("Strategy outcome needs at least one option leg");
+    }
+    OptionChain chain = buildChain(spec, market, market.volatility, config);
+    const std::vector<OptionChain::ExpiryGroup>& groups = chain.getExpiryGroups();
+    if (groups.size() > 1) {
+        return simulateOutcome(spec, chain, premiums, levels, config);
+    }
+    
+    const OptionChain::ExpiryGroup& expiry = groups.front();
+    TerminalDistribution law = config.volatilitySurface
+        ? TerminalDistribution(expiry.forward, expiry.timeToMaturity, config.volatilitySurface)
+        : TerminalDistribution(expiry.forward, market.volatility, expiry.timeToMaturity);
+    PayoffProfile payoff = profile(spec, premiums);
+    
+    StrategyOutcome result;
+    result.probabilityOfProfit = payoff.probabilityOfProfit(law);
+    result.expectedPnL = payoff.expectedValue(law);
+    result.cumulative = payoff.cumulativeProbabilities(law, levels);
+    result.simulated = false;
+    return result;
+}
+
+StrategyOutcome StrategyEngine::simulateOutcome(const StrategySpec& spec, const OptionChain& chain,
+                                                const std::vector<double>& premiums,
+                                                const std::vector<double>& levels,
+                                                const PricingConfig& config) const {
+    const std::vector<OptionChain::ExpiryGroup>& groups = chain.getExpiryGroups();
+    const size_t numPaths = static_cast<size_t>(std::max(config.monteCarloSimulations, 1));
+    
+    // Paths at the expiry dates only, drifting at the flat carry that reproduces
+    // the last expiry's forward
+    std::vector<double> timeGrid(groups.size());
+    for (size_t g = 0; g < groups.size(); ++g) {
+        timeGrid[g] = groups[g].timeToMaturity;
+    }
+    double spot = chain.getUnderlyings()[0].spot;
+    double carry = std::log(groups.back().forward / spot) / groups.back().timeToMaturity;
+    double volatility = chain.volatilities()[0];
+    
+    std::vector<double> spots(groups.size() * numPaths);
+    std::mt19937 generator(config.seed);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    for (size_t i = 0; i < spots.size(); ++i) {
+        spots[i] = normal(generator);
+    }
+    monteCarloEngine_.evolvePaths(spot, carry, volatility, timeGrid, numPaths, spots.data());
+    
+    double premiumCost = 0.0;
+    for (size_t leg = 0; leg < spec.legs.size(); ++leg) {
+        premiumCost += spec.legs[leg].quantity * premiums[leg];
+    }
+    const double* finalSpots = &spots[(groups.size() - 1) * numPaths];
+    std::vector<double> pnl(numPaths);
+    for (size_t path = 0; path < numPaths; ++path) {
+        pnl[path] = spec.stockQuantity * (finalSpots[path] - spec.stockEntryPrice) - premiumCost;
+    }
+    
+    // Each leg settles against the spot at its own expiry
+    for (size_t g = 0; g < groups.size(); ++g) {
+        const double* dateSpots = &spots[g * numPaths];
+        for (size_t leg = groups[g].begin; leg < groups[g].end; ++leg) {
+            double phi = (chain.types()[leg] == OptionType::CALL) ? 1.0 : -1.0;
+            double strike = chain.strikes()[leg];
+            double quantity = chain.quantities()[leg];
+            for (size_t path = 0; path < numPaths; ++path) {
+                pnl[path] += quantity * std::max(phi * (dateSpots[path] - strike), 0.0);
+            }
+        }
+    }
+    
+    StrategyOutcome result;
+    double total = 0.0;
+    for (size_t path = 0; path < numPaths; ++path) {
+        total += pnl[path];
+    }
+    std::sort(pnl.begin(), pnl.end());
+    result.expectedPnL = total / numPaths;
+    result.probabilityOfProfit = static_cast<double>(pnl.end() - std::upper_bound(pnl.begin(), pnl.end(), 0.0)) /
+                                 numPaths;
+    result.cumulative.resize(levels.size());
+    for (size_t i = 0; i < levels.size(); ++i) {
+        result.cumulative[i] = static_cast<double>(std::upper_bound(pnl.begin(), pnl.end(), levels[i]) - pnl.begin()) /
+                               numPaths;
+    }
+    result.simulated = true;
+    return result;
+}
+
+OptionChain StrategyEngine::buildChain(const StrategySpec& spec, const StrategyMarket& market, double volatility,
+                                       const PricingConfig& config) {
+    OptionChain chain;
+    size_t underlying = chain.addUnderlying("strategy", market.spot, market.rate);
+    if (config.termStructure) {
+        chain.setTermStructure(underlying, config.termStructure);
+    } else if (market.dividendYield != 0.0) {
+        chain.setTermStructure(underlying, std::make_shared<TermStructure>(YieldCurve(market.rate),
+                                                                           YieldCurve(market.dividendYield)));
+    }
+    
+    for (const auto& leg : spec.legs) {
+        if (leg.strike <= 0.0 || leg.timeToMaturity <= 0.0) {
+            throw std::invalid_argument("Strategy legs need a positive strike and time to maturity");
+        }
+        chain.addOption(underlying, leg.strike, leg.timeToMaturity, volatility, leg.type, leg.exercise, leg.quantity);
+    }
+    chain.finalize();
+    return chain;
+}
+
+PayoffProfile StrategyEngine::profile(const StrategySpec& spec, const std::vector<double>& premiums) {
+    if (premiums.size() != spec.legs.size()) {
+        throw std::invalid_argument("Need one premium per strategy leg");
+    }
+    std::vector<PayoffLeg> legs;
+    legs.reserve(spec.legs.size());
+    for (size_t leg = 0; leg < spec.legs.size(); ++leg) {
+        PayoffLeg payoffLeg = { spec.legs[leg].type, spec.legs[leg].strike, spec.legs[leg].quantity, premiums[leg] };
+        legs.push_back(payoffLeg);
+    }
+    return PayoffProfile(legs, spec.stockQuantity, spec.stockEntryPrice);
+}
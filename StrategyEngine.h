@@ -0,0 +1,119 @@
+// StrategyEngine.h
+#ifndef STRATEGY_ENGINE_H
+#define STRATEGY_ENGINE_H
+
+#include "OptionsPricingEngine.h"
+#include "PayoffProfile.h"
+#include <vector>
+
+struct StrategyLeg {
+    OptionType type;
+    double strike;
+    double timeToMaturity;
+    double quantity;  // positive long, negative short
+    ExerciseType exercise;
+};
+
+// Any combination of option legs on one underlying, plus shares held outright
+struct StrategySpec {
+    std::vector<StrategyLeg> legs;
+    double stockQuantity = 0.0;
+    double stockEntryPrice = 0.0;
+};
+
+struct StrategyMarket {
+    double spot;
+    double rate;
+    double volatility;
+    double dividendYield = 0.0;
+};
+
+struct StrategyAnalysis {
+    std::vector<double> premiums;  // per unit, in leg order
+    double netPremium;             // received minus paid
+    double maxProfit;              // infinity when unbounded
+    double maxLoss;                // positive size, infinity when unbounded
+    std::vector<double> breakevens;
+    std::vector<double> pnl;       // expiry P&L at the requested spots
+};
+
+// Mark-to-model P&L over a spot grid at one horizon and volatility
+struct HorizonCurve {
+    double horizon;     // years elapsed from today
+    double volatility;
+    std::vector<double> pnl;
+};
+
+// Expiry P&L statistics under the risk-neutral law of the underlying
+struct StrategyOutcome {
+    double probabilityOfProfit;
+    double expectedPnL;              // undiscounted, premiums taken at cost
+    std::vector<double> cumulative;  // P(P&L <= level) at the requested levels
+    bool simulated;                  // Monte Carlo fallback rather than closed form
+};
+
+// Prices and analyses arbitrary multi-leg strategies, so a new strategy is a new
+// list of legs rather than a new code path. All legs go into one OptionChain and
+// are priced in a single Black-Scholes chain pass; American legs are then priced
+// together on the binomial engine (which uses American price tables when set).
+//
+// Expiry P&L takes every leg to its own expiry at a common terminal spot, which
+// is exact for single-expiry strategies. Horizon curves instead revalue the legs
+// still alive at each horizon.
+class StrategyEngine {
+public:
+    explicit StrategyEngine(OptionsPricingEngine& pricer);
+    
+    // Overloads without a PricingConfig use the pricer's default configuration
+    std::vector<double> premiums(const StrategySpec& spec, const StrategyMarket& market);
+    std::vector<double> premiums(const StrategySpec& spec, const StrategyMarket& market, const PricingConfig& config);
+    
+    StrategyAnalysis analyze(const StrategySpec& spec, const StrategyMarket& market, const std::vector<double>& spots);
+    StrategyAnalysis analyze(const StrategySpec& spec, const StrategyMarket& market, const std::vector<double>& spots,
+                             const PricingConfig& config);
+    
+    // P&L against the given entry premiums for every (horizon, volatility) pair,
+    // horizon-major. Legs expiring by a horizon contribute their payoff; live
+    // European legs are revalued per expiry group with the vectorized
+    // Black-Scholes kernel, live American legs on one binomial tree each. Rates and
+    // yields are the chain's flat equivalents per expiry and volatilities are
+    // flat, so a volatility surface in the config is not consulted.
+    std::vector<HorizonCurve> horizonCurves(const StrategySpec& spec, const StrategyMarket& market,
+                                            const std::vector<double>& premiums, const std::vector<double>& spots,
+                                            const std::vector<double>& horizons,
+                                            const std::vector<double>& volatilities);
+    std::vector<HorizonCurve> horizonCurves(const StrategySpec& spec, const StrategyMarket& market,
+                                            const std::vector<double>& premiums, const std::vector<double>& spots,
+                                            const std::vector<double>& horizons,
+                                            const std::vector<double>& volatilities, const PricingConfig& config);
+    
+    // Closed form when every leg shares one expiry: the piecewise-linear payoff is
+    // integrated segment by segment against the lognormal law at the market vol,
+    // or the smile-implied law when the config carries a volatility surface.
+    // Strategies over several expiries depend on the path between them and are
+    // simulated with config.monteCarloSimulations paths at the market vol, each
+    // leg settling at its own expiry. American legs are taken as held to expiry.
+    StrategyOutcome outcome(const StrategySpec& spec, const StrategyMarket& market,
+                            const std::vector<double>& premiums, const std::vector<double>& levels);
+    StrategyOutcome outcome(const StrategySpec& spec, const StrategyMarket& market,
+                            const std::vector<double>& premiums, const std::vector<double>& levels,
+                            const PricingConfig& config);
+    
+    static PayoffProfile profile(const StrategySpec& spec, const std::vector<double>& premiums);
+    
+    // Finalized chain of the strategy's legs at one volatility, carrying the config's
+    // term structure or else the market's dividend yield; leg ids index spec.legs
+    static OptionChain buildChain(const StrategySpec& spec, const StrategyMarket& market, double volatility,
+                                  const PricingConfig& config);
+
+private:
+    OptionsPricingEngine& pricer_;
+    BlackScholesEngine blackScholesEngine_;
+    MonteCarloEngine monteCarloEngine_;
+    
+    StrategyOutcome simulateOutcome(const StrategySpec& spec, const OptionChain& chain,
+                                    const std::vector<double>& premiums, const std::vector<double>& levels,
+                                    const PricingConfig& config) const;
+};
+
+#endif
@@ -0,0 +1,406 @@
+#include "StrategySearchEngine.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <stdexcept>
+
+namespace {
+
+const size_t MAX_LEGS = 4;
+
+// Per-strike SoA cache: premiums, and the expected P&L of holding one unit long
+// to expiry, E[payoff] - premium
+struct ChainCache {
+    std::vector<double> strike;
+    std::vector<double> callPremium, putPremium;
+    std::vector<double> callValue, putValue;
+    std::vector<double> tail;  // P(S_T > strike)
+    const TerminalDistribution* law;
+};
+
+// Legs by ascending strike index; equal indices are allowed (iron butterflies)
+struct Combination {
+    StrategyFamily family;
+    size_t legCount;
+    size_t index[MAX_LEGS];
+    bool call[MAX_LEGS];
+    double quantity[MAX_LEGS];
+    double netPremium, expectedPnL, probabilityOfProfit, maxLoss, maxProfit, score;
+};
+
+bool betterScore(const Combination& a, const Combination& b) {
+    return a.score > b.score;
+}
+
+// Bounded min-heap on score holding the best k combinations seen
+class TopK {
+public:
+    explicit TopK(size_t k) : k_(k) { heap_.reserve(k); }
+    
+    bool full() const { return heap_.size() >= k_; }
+    double threshold() const { return full() ? heap_.front().score : -std::numeric_limits<double>::infinity(); }
+    
+    void offer(const Combination& combination) {
+        if (k_ == 0) return;
+        if (!full()) {
+            heap_.push_back(combination);
+            std::push_heap(heap_.begin(), heap_.end(), betterScore);
+        } else if (combination.score > heap_.front().score) {
+            std::pop_heap(heap_.begin(), heap_.end(), betterScore);
+            heap_.back() = combination;
+            std::push_heap(heap_.begin(), heap_.end(), betterScore);
+        }
+    }
+    
+    const std::vector<Combination>& items() const { return heap_; }
+
+private:
+    size_t k_;
+    std::vector<Combination> heap_;
+};
+
+// Expiry P&L metrics of a combination from the cache: the P&L is piecewise
+// linear with kinks at the leg strikes, so extremes are kink values and the
+// probability of profit is the law's mass over the positive segments
+void evaluate(const ChainCache& cache, StrategyObjective objective, Combination& c) {
+    c.netPremium = 0.0;
+    c.expectedPnL = 0.0;
+    double putQuantity = 0.0, callQuantity = 0.0;
+    for (size_t leg = 0; leg < c.legCount; ++leg) {
+        size_t s = c.index[leg];
+        double q = c.quantity[leg];
+        c.netPremium -= q * (c.call[leg] ? cache.callPremium[s] : cache.putPremium[s]);
+        c.expectedPnL += q * (c.call[leg] ? cache.callValue[s] : cache.putValue[s]);
+        (c.call[leg] ? callQuantity : putQuantity) += q;
+    }
+    
+    // P&L at S = 0 and at each distinct kink
+    double points[MAX_LEGS + 1], values[MAX_LEGS + 1], tails[MAX_LEGS + 1];
+    size_t count = 0;
+    points[0] = 0.0;
+    tails[0] = 1.0;
+    values[0] = c.netPremium;
+    for (size_t leg = 0; leg < c.legCount; ++leg) {
+        if (!c.call[leg]) values[0] += c.quantity[leg] * cache.strike[c.index[leg]];
+    }
+    for (size_t leg = 0; leg < c.legCount; ++leg) {
+        if (leg > 0 && c.index[leg] == c.index[leg - 1]) continue;
+        double x = cache.strike[c.index[leg]];
+        double value = c.netPremium;
+        for (size_t other = 0; other < c.legCount; ++other) {
+            double strike = cache.strike[c.index[other]];
+            value += c.quantity[other] * (c.call[other] ? std::max(x - strike, 0.0) : std::max(strike - x, 0.0));
+        }
+        ++count;
+        points[count] = x;
+        values[count] = value;
+        tails[count] = cache.tail[c.index[leg]];
+    }
+    
+    const double infinity = std::numeric_limits<double>::infinity();
+    double lowest = *std::min_element(values, values + count + 1);
+    double highest = *std::max_element(values, values + count + 1);
+    c.maxLoss = (callQuantity < 0.0) ? infinity : std::max(-lowest, 0.0);
+    c.maxProfit = (callQuantity > 0.0) ? infinity : highest;
+    
+    double probability = 0.0;
+    for (size_t k = 0; k < count; ++k) {
+        double left = values[k], right = values[k + 1];
+        if (left > 0.0 && right > 0.0) {
+            probability += tails[k] - tails[k + 1];
+        } else if (left > 0.0 || right > 0.0) {
+            double cross = points[k] + left * (points[k + 1] - points[k]) / (left - right);
+            double crossTail = cache.law->probabilityAbove(cross);
+            probability += (left > 0.0) ? tails[k] - crossTail : crossTail - tails[k + 1];
+        }
+    }
+    double last = values[count];
+    if (callQuantity == 0.0) {
+        if (last > 0.0) probability += tails[count];
+    } else {
+        double cross = points[count] - last / callQuantity;
+        if (last > 0.0) {
+            probability += (callQuantity > 0.0) ? tails[count] : tails[count] - cache.law->probabilityAbove(cross);
+        } else if (callQuantity > 0.0) {
+            probability += cache.law->probabilityAbove(cross);
+        }
+    }
+    c.probabilityOfProfit = std::min(std::max(probability, 0.0), 1.0);
+    
+    switch (objective) {
+        case StrategyObjective::EXPECTED_VALUE:
+            c.score = c.expectedPnL;
+            break;
+        case StrategyObjective::PROBABILITY_OF_PROFIT:
+            c.score = c.probabilityOfProfit;
+            break;
+        case StrategyObjective::RETURN_ON_RISK:
+            c.score = (c.maxLoss > 0.0) ? c.expectedPnL / c.maxLoss : infinity;
+            break;
+    }
+}
+
+Combination makeVertical(StrategyFamily family, size_t lower, size_t upper) {
+    Combination c;
+    c.family = family;
+    c.legCount = 2;
+    c.index[0] = lower;
+    c.index[1] = upper;
+    bool call = family == StrategyFamily::BULL_CALL_SPREAD || family == StrategyFamily::BEAR_CALL_SPREAD;
+    bool longLower = family == StrategyFamily::BULL_CALL_SPREAD || family == StrategyFamily::BULL_PUT_SPREAD;
+    c.call[0] = c.call[1] = call;
+    c.quantity[0] = longLower ? 1.0 : -1.0;
+    c.quantity[1] = -c.quantity[0];
+    return c;
+}
+
+}
+
+StrategySearchEngine::StrategySearchEngine(OptionsPricingEngine& pricer, ThreadPool& pool)
+    : pricer_(pricer), pool_(pool) {}
+
+std::vector<StrategyCandidate> StrategySearchEngine::search(const StrategyMarket& market, double timeToMaturity,
+                                                            const std::vector<double>& strikes,
+                                                            const StrategySearchSettings& settings,
+                                                            StrategySearchStats* stats) {
+    const size_t n = strikes.size();
+    if (n < 2 || timeToMaturity <= 0.0) {
+        throw std::invalid_argument("Search needs at least two strikes and a positive maturity");
+    }
+    for (size_t s = 0; s < n; ++s) {
+        if (strikes[s] <= 0.0 || (s > 0 && strikes[s] <= strikes[s - 1])) {
+            throw std::invalid_argument("Search strikes must be positive and strictly ascending");
+        }
+    }
+    
+    // Every chain member priced once: a call and a put per strike, in one chain pass
+    const PricingConfig& config = pricer_.getDefaultConfig();
+    StrategySpec members;
+    for (size_t s = 0; s < n; ++s) {
+        StrategyLeg call = { OptionType::CALL, strikes[s], timeToMaturity, 1.0, ExerciseType::EUROPEAN };
+        StrategyLeg put = { OptionType::PUT, strikes[s], timeToMaturity, 1.0, ExerciseType::EUROPEAN };
+        members.legs.push_back(call);
+        members.legs.push_back(put);
+    }
+    OptionChain chain = StrategyEngine::buildChain(members, market, market.volatility, config);
+    std::vector<double> prices;
+    pricer_.priceChain(chain, PricingMethod::BLACK_SCHOLES, config, prices);
+    
+    double forward = (settings.viewForward > 0.0) ? settings.viewForward : chain.getExpiryGroups().front().forward;
+    TerminalDistribution law = (settings.viewVolatility > 0.0)
+        ? TerminalDistribution(forward, settings.viewVolatility, timeToMaturity)
+        : config.volatilitySurface ? TerminalDistribution(forward, timeToMaturity, config.volatilitySurface)
+                                   : TerminalDistribution(forward, market.volatility, timeToMaturity);
+    
+    ChainCache cache;
+    cache.strike = strikes;
+    cache.callPremium.resize(n);
+    cache.putPremium.resize(n);
+    cache.callValue.resize(n);
+    cache.putValue.resize(n);
+    cache.tail.resize(n);
+    cache.law = &law;
+    for (size_t leg = 0; leg < chain.size(); ++leg) {
+        size_t id = chain.legId(leg);
+        (id % 2 == 0 ? cache.callPremium : cache.putPremium)[id / 2] = prices[leg];
+    }
+    for (size_t s = 0; s < n; ++s) {
+        double expectedCall = law.expectedCall(strikes[s]);
+        cache.callValue[s] = expectedCall - cache.callPremium[s];
+        cache.putValue[s] = expectedCall - (forward - strikes[s]) - cache.putPremium[s];
+        cache.tail[s] = law.probabilityAbove(strikes[s]);
+    }
+    
+    bool condors = false;
+    std::vector<StrategyFamily> verticals;
+    for (auto it = settings.families.begin(); it != settings.families.end(); ++it) {
+        if (*it == StrategyFamily::IRON_CONDOR) {
+            condors = true;
+        } else if (std::find(verticals.begin(), verticals.end(), *it) == verticals.end()) {
+            verticals.push_back(*it);
+        }
+    }
+    
+    // Best call spread short at k over any wider long call, and suffix maxima over
+    // k' >= k: upper bounds on what the call side of a condor can still add
+    const double infinity = std::numeric_limits<double>::infinity();
+    std::vector<double> callCredit(n, -infinity), callValue(n, -infinity);
+    std::vector<double> suffixCredit(n + 1, -infinity), suffixValue(n + 1, -infinity);
+    if (condors) {
+        double lowestPremium = infinity, bestValue = -infinity;
+        for (size_t k = n; k-- > 0;) {
+            if (k + 1 < n) {
+                callCredit[k] = cache.callPremium[k] - lowestPremium;
+                callValue[k] = bestValue - cache.callValue[k];
+            }
+            suffixCredit[k] = std::max(suffixCredit[k + 1], callCredit[k]);
+            suffixValue[k] = std::max(suffixValue[k + 1], callValue[k]);
+            lowestPremium = std::min(lowestPremium, cache.callPremium[k]);
+            bestValue = std::max(bestValue, cache.callValue[k]);
+        }
+    }
+    
+    // A condor with credit c is profitable on (K2 - c, K3 + c), plus a whole wing
+    // once c exceeds that wing's width, so the most credit a subtree can collect
+    // bounds its probability of profit
+    auto lowerTail = [&](double putWidth, double shortPut, double maxCredit) {
+        return (maxCredit >= putWidth) ? 1.0 : law.probabilityAbove(shortPut - maxCredit);
+    };
+    
+    // Return on risk is at most the best expected P&L over the least loss
+    auto returnBound = [&](double maxValue, double minLoss) {
+        return (maxValue <= 0.0) ? 0.0 : (minLoss <= 0.0) ? infinity : maxValue / minLoss;
+    };
+    
+    const bool valueBound = settings.objective == StrategyObjective::EXPECTED_VALUE;
+    const bool profitBound = settings.objective == StrategyObjective::PROBABILITY_OF_PROFIT;
+    const bool returnOnRisk = settings.objective == StrategyObjective::RETURN_ON_RISK;
+    TopK best(settings.topK);
+    std::mutex mutex;
+    std::atomic<double> sharedThreshold(-infinity);
+    std::atomic<uint64_t> enumerated(0), evaluated(0);
+    
+    // One task per lowest strike, nearest the forward first since those tend to
+    // score best; later tasks prune against the K-th best so far
+    std::vector<size_t> order(n);
+    for (size_t s = 0; s < n; ++s) {
+        order[s] = s;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return std::fabs(strikes[a] - forward) < std::fabs(strikes[b] - forward);
+    });
+    
+    pool_.parallelFor(n, 1, [&](size_t first, size_t last) {
+        TopK local(settings.topK);
+        uint64_t localEnumerated = 0, localEvaluated = 0;
+        auto threshold = [&]() { return std::max(local.threshold(), sharedThreshold.load()); };
+        auto consider = [&](Combination& c) {
+            evaluate(cache, settings.objective, c);
+            if (c.maxLoss <= settings.maxLoss && c.netPremium >= settings.minCredit) {
+                ++localEvaluated;
+                local.offer(c);
+            }
+        };
+        
+        for (size_t position = first; position < last; ++position) {
+            size_t i = order[position];
+            for (auto family = verticals.begin(); family != verticals.end(); ++family) {
+                for (size_t j = i + 1; j < n; ++j) {
+                    ++localEnumerated;
+                    Combination c = makeVertical(*family, i, j);
+                    consider(c);
+                }
+            }
+            if (!condors) {
+                continue;
+            }
+            
+            // Long put i, short put j, short call k, long call l
+            for (size_t j = i + 1; j + 1 < n; ++j) {
+                double putCredit = cache.putPremium[j] - cache.putPremium[i];
+                double putValue = cache.putValue[i] - cache.putValue[j];
+                double putWidth = strikes[j] - strikes[i];
+                ++localEnumerated;
+                double maxCredit = putCredit + suffixCredit[j];
+                if (maxCredit < settings.minCredit || putWidth - maxCredit > settings.maxLoss ||
+                    (valueBound && putValue + suffixValue[j] <= threshold()) ||
+                    (profitBound && lowerTail(putWidth, strikes[j], maxCredit) <= threshold()) ||
+                    (returnOnRisk && returnBound(putValue + suffixValue[j], putWidth - maxCredit) <= threshold())) {
+                    continue;
+                }
+                
+                for (size_t k = j; k + 1 < n; ++k) {
+                    ++localEnumerated;
+                    maxCredit = putCredit + callCredit[k];
+                    if (maxCredit < settings.minCredit || putWidth - maxCredit > settings.maxLoss ||
+                        (valueBound && putValue + callValue[k] <= threshold())) {
+                        continue;
+                    }
+                    if (profitBound) {
+                        // The call wing's loss is smallest for the narrowest spread
+                        bool openAbove = putCredit + cache.callPremium[k] - cache.callPremium[k + 1] >
+                                         strikes[k + 1] - strikes[k];
+                        double bound = lowerTail(putWidth, strikes[j], maxCredit) -
+                                       (openAbove ? 0.0 : law.probabilityAbove(strikes[k] + maxCredit));
+                        if (bound <= threshold()) {
+                            continue;
+                        }
+                    }
+                    if (returnOnRisk) {
+                        // The call wing's own loss grows with its width, so it is least at l = k + 1
+                        double callWingLoss = strikes[k + 1] - strikes[k] - putCredit -
+                                              (cache.callPremium[k] - cache.callPremium[k + 1]);
+                        double minLoss = std::max(putWidth - maxCredit, callWingLoss);
+                        if (returnBound(putValue + callValue[k], minLoss) <= threshold()) {
+                            continue;
+                        }
+                    }
+                    for (size_t l = k + 1; l < n; ++l) {
+                        ++localEnumerated;
+                        double credit = putCredit + cache.callPremium[k] - cache.callPremium[l];
+                        double loss = std::max(putWidth, strikes[l] - strikes[k]) - credit;
+                        double value = putValue + cache.callValue[l] - cache.callValue[k];
+                        if (credit < settings.minCredit || loss > settings.maxLoss ||
+                            (valueBound && value <= threshold()) ||
+                            (returnOnRisk && returnBound(value, loss) <= threshold())) {
+                            continue;
+                        }
+                        Combination c;
+                        c.family = StrategyFamily::IRON_CONDOR;
+                        c.legCount = 4;
+                        c.index[0] = i;
+                        c.index[1] = j;
+                        c.index[2] = k;
+                        c.index[3] = l;
+                        c.call[0] = c.call[1] = false;
+                        c.call[2] = c.call[3] = true;
+                        c.quantity[0] = 1.0;
+                        c.quantity[1] = -1.0;
+                        c.quantity[2] = -1.0;
+                        c.quantity[3] = 1.0;
+                        consider(c);
+                    }
+                }
+            }
+        }
+        
+        enumerated += localEnumerated;
+        evaluated += localEvaluated;
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto it = local.items().begin(); it != local.items().end(); ++it) {
+            best.offer(*it);
+        }
+        if (best.full()) {
+            sharedThreshold.store(best.threshold());
+        }
+    });
+    
+    std::vector<Combination> ranked = best.items();
+    std::sort(ranked.begin(), ranked.end(), betterScore);
+    
+    std::vector<StrategyCandidate> candidates;
+    candidates.reserve(ranked.size());
+    for (auto it = ranked.begin(); it != ranked.end(); ++it) {
+        StrategyCandidate candidate;
+        candidate.family = it->family;
+        for (size_t leg = 0; leg < it->legCount; ++leg) {
+            StrategyLeg strategyLeg = { it->call[leg] ? OptionType::CALL : OptionType::PUT, strikes[it->index[leg]],
+                                        timeToMaturity, it->quantity[leg], ExerciseType::EUROPEAN };
+            candidate.spec.legs.push_back(strategyLeg);
+        }
+        candidate.netPremium = it->netPremium;
+        candidate.expectedPnL = it->expectedPnL;
+        candidate.probabilityOfProfit = it->probabilityOfProfit;
+        candidate.maxLoss = it->maxLoss;
+        candidate.maxProfit = it->maxProfit;
+        candidate.score = it->score;
+        candidates.push_back(candidate);
+    }
+    
+    if (stats) {
+        stats->enumerated = enumerated.load();
+        stats->evaluated = evaluated.load();
+    }
+    return candidates;
+}
@@ -0,0 +1,87 @@
+// StrategySearchEngine.h
+#ifndef STRATEGY_SEARCH_ENGINE_H
+#define STRATEGY_SEARCH_ENGINE_H
+
+#include "StrategyEngine.h"
+#include "TerminalDistribution.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Defined-risk structures the search enumerates, named from the holder's side
+enum class StrategyFamily {
+    BULL_CALL_SPREAD,   // long call K1, short call K2
+    BEAR_PUT_SPREAD,    // short put K1, long put K2
+    BULL_PUT_SPREAD,    // long put K1, short put K2 (credit)
+    BEAR_CALL_SPREAD,   // short call K1, long call K2 (credit)
+    IRON_CONDOR         // long put K1, short put K2, short call K3, long call K4, K2 <= K3
+};
+
+enum class StrategyObjective {
+    EXPECTED_VALUE,
+    PROBABILITY_OF_PROFIT,
+    RETURN_ON_RISK      // expected P&L per unit of max loss
+};
+
+struct StrategySearchSettings {
+    std::vector<StrategyFamily> families = { StrategyFamily::BULL_CALL_SPREAD, StrategyFamily::BEAR_PUT_SPREAD,
+                                             StrategyFamily::BULL_PUT_SPREAD, StrategyFamily::BEAR_CALL_SPREAD,
+                                             StrategyFamily::IRON_CONDOR };
+    StrategyObjective objective = StrategyObjective::EXPECTED_VALUE;
+    size_t topK = 10;
+    double maxLoss = std::numeric_limits<double>::infinity();
+    double minCredit = -std::numeric_limits<double>::infinity();  // net premium received; negative allows debits
+    
+    // The trader's view of the terminal law; under the pricing law itself every
+    // combination's expected P&L is just premium carry. Zero keeps the
+    // risk-neutral forward and the pricing volatility (or surface).
+    double viewForward = 0.0;
+    double viewVolatility = 0.0;
+};
+
+struct StrategyCandidate {
+    StrategyFamily family;
+    StrategySpec spec;
+    double netPremium;
+    double expectedPnL;
+    double probabilityOfProfit;
+    double maxLoss;
+    double maxProfit;
+    double score;
+};
+
+struct StrategySearchStats {
+    uint64_t enumerated;  // combinations reached, after pruning whole subtrees
+    uint64_t evaluated;   // combinations that passed the constraints and were scored
+};
+
+// Ranks strike combinations of one expiry by expected value, probability of
+// profit or return on risk. Every chain member is priced once, and its expected
+// payoff and tail probability under the terminal law are cached alongside in
+// flat per-strike arrays, so a combination's metrics are a few lookups. Iron
+// condors are enumerated put spread first, in parallel over the lowest strike
+// taken nearest the forward first, with suffix maxima of the call spreads'
+// credit and expected value bounding whole subtrees against the credit and
+// max-loss constraints and against the current K-th best score; probability of
+// profit is bounded by the mass above the lower breakeven, return on risk by
+// the best expected value over the smallest admissible max loss.
+class StrategySearchEngine {
+public:
+    explicit StrategySearchEngine(OptionsPricingEngine& pricer,
+                                  ThreadPool& pool = ThreadPool::shared());
+    
+    // European calls and puts at every strike, priced with the pricer's default
+    // configuration (volatility surface and term structure included). Metrics are
+    // taken under the settings' view, by default the pricing law.
+    std::vector<StrategyCandidate> search(const StrategyMarket& market, double timeToMaturity,
+                                          const std::vector<double>& strikes,
+                                          const StrategySearchSettings& settings,
+                                          StrategySearchStats* stats = nullptr);
+
+private:
+    OptionsPricingEngine& pricer_;
+    ThreadPool& pool_;
+};
+
+#endif
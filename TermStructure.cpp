@@ -0,0 +1,77 @@
+#include "TermStructure.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+YieldCurve::YieldCurve(double flatRate) : times_(1, 1.0), logDiscounts_(1, -flatRate) {}
+
+YieldCurve::YieldCurve(const std::vector<double>& times, const std::vector<double>& zeroRates) {
+    if (times.empty() || times.size() != zeroRates.size()) {
+        throw std::invalid_argument("Need one zero rate per curve pillar");
+    }
+    for (size_t i = 0; i < times.size(); ++i) {
+        if (times[i] <= 0.0 || (i > 0 && times[i] <= times[i - 1])) {
+            throw std::invalid_argument("Curve pillars must be positive and strictly increasing");
+        }
+        times_.push_back(times[i]);
+        logDiscounts_.push_back(-zeroRates[i] * times[i]);
+    }
+}
+
+double YieldCurve::discountFactor(double t) const {
+    if (t <= 0.0) {
+        return 1.0;
+    }
+    
+    size_t upper = std::upper_bound(times_.begin(), times_.end(), t) - times_.begin();
+    if (upper == times_.size()) {
+        return std::exp(logDiscounts_.back() / times_.back() * t);
+    }
+    
+    // Log discount factor is 0 at t = 0, which anchors the first segment
+    double t0 = (upper == 0) ? 0.0 : times_[upper - 1];
+    double y0 = (upper == 0) ? 0.0 : logDiscounts_[upper - 1];
+    double weight = (t - t0) / (times_[upper] - t0);
+    return std::exp(y0 + weight * (logDiscounts_[upper] - y0));
+}
+
+double YieldCurve::zeroRate(double t) const {
+    if (t <= 0.0) {
+        return -logDiscounts_.front() / times_.front();
+    }
+    return -std::log(discountFactor(t)) / t;
+}
+
+TermStructure::TermStructure(const YieldCurve& rates, const YieldCurve& dividendYields,
+                             const std::vector<CashDividend>& dividends)
+    : rates_(rates), dividendYields_(dividendYields), dividends_(dividends) {
+    std::sort(dividends_.begin(), dividends_.end(), [](const CashDividend& x, const CashDividend& y) {
+        return x.time < y.time;
+    });
+}
+
+TermStructure::Factors TermStructure::factorsAt(double timeToMaturity) const {
+    Factors factors;
+    factors.discountFactor = rates_.discountFactor(timeToMaturity);
+    factors.dividendFactor = dividendYields_.discountFactor(timeToMaturity);
+    factors.rate = rates_.zeroRate(timeToMaturity);
+    factors.dividendYield = dividendYields_.zeroRate(timeToMaturity);
+    
+    factors.dividendPV = 0.0;
+    for (auto it = dividends_.begin(); it != dividends_.end() && it->time <= timeToMaturity; ++it) {
+        if (it->time > 0.0) {
+            factors.dividendPV += it->amount * rates_.discountFactor(it->time);
+        }
+    }
+    return factors;
+}
+
+Option TermStructure::applyTo(const Option& option) const {
+    Factors factors = factorsAt(option.getTimeToMaturity());
+    double spot = option.getSpot() - factors.dividendPV;
+    if (spot <= 0.0) {
+        throw std::invalid_argument("Cash dividends exceed the spot price");
+    }
+    return Option(spot, option.getStrike(), factors.rate, option.getVolatility(), option.getTimeToMaturity(),
+                  option.getOptionType(), option.getExerciseType(), factors.dividendYield);
+}
@@ -0,0 +1,59 @@
+// TermStructure.h
+#ifndef TERM_STRUCTURE_H
+#define TERM_STRUCTURE_H
+
+#include "Option.h"
+#include <vector>
+
+// Continuously compounded zero curve, interpolated linearly in log discount factor
+// (piecewise-flat forwards). Beyond the last pillar the last zero rate is held.
+class YieldCurve {
+public:
+    explicit YieldCurve(double flatRate = 0.0);
+    YieldCurve(const std::vector<double>& times, const std::vector<double>& zeroRates);
+    
+    double discountFactor(double t) const;
+    double zeroRate(double t) const;
+
+private:
+    std::vector<double> times_;
+    std::vector<double> logDiscounts_;  // -r(t) * t at each pillar
+};
+
+struct CashDividend {
+    double time;
+    double amount;
+};
+
+// Rates and dividends of one underlying. Continuous dividend yields are a zero
+// curve of their own; cash dividends are handled by the escrowed-dividend model,
+// i.e. the spot is reduced by the present value of those paid before expiry.
+class TermStructure {
+public:
+    // Everything the pricers need for one expiry
+    struct Factors {
+        double discountFactor;   // P(0, T)
+        double dividendFactor;   // exp(-q(T) T)
+        double dividendPV;       // PV of cash dividends paid in (0, T]
+        double rate;             // zero rate to T
+        double dividendYield;    // continuous yield to T
+        
+        double forward(double spot) const { return (spot - dividendPV) * dividendFactor / discountFactor; }
+    };
+    
+    explicit TermStructure(const YieldCurve& rates, const YieldCurve& dividendYields = YieldCurve(),
+                           const std::vector<CashDividend>& dividends = std::vector<CashDividend>());
+    
+    Factors factorsAt(double timeToMaturity) const;
+    
+    // The option re-expressed with flat equivalents for its own expiry: escrowed
+    // spot, zero rate and continuous yield
+    Option applyTo(const Option& option) const;
+
+private:
+    YieldCurve rates_;
+    YieldCurve dividendYields_;
+    std::vector<CashDividend> dividends_;
+};
+
+#endif
@@ -0,0 +1,73 @@
+#include "TerminalDistribution.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+double normalCdf(double x) {
+    return 0.5 * std::erfc(-x * M_SQRT1_2);
+}
+
+double normalPdf(double x) {
+    return std::exp(-0.5 * x * x) / std::sqrt(2.0 * M_PI);
+}
+
+}
+
+TerminalDistribution::TerminalDistribution(double forward, double volatility, double timeToMaturity)
+    : forward_(forward), volatility_(volatility), timeToMaturity_(timeToMaturity),
+      sqrtT_(std::sqrt(timeToMaturity)) {
+    if (forward <= 0.0 || volatility <= 0.0 || timeToMaturity <= 0.0) {
+        throw std::invalid_argument("Terminal distribution needs a positive forward, volatility and maturity");
+    }
+}
+
+TerminalDistribution::TerminalDistribution(double forward, double timeToMaturity,
+                                           std::shared_ptr<const VolatilitySurface> surface)
+    : forward_(forward), volatility_(0.0), timeToMaturity_(timeToMaturity), sqrtT_(std::sqrt(timeToMaturity)),
+      surface_(surface) {
+    if (forward <= 0.0 || timeToMaturity <= 0.0 || !surface) {
+        throw std::invalid_argument("Terminal distribution needs a positive forward and maturity and a surface");
+    }
+    slice_ = surface_->sliceAt(timeToMaturity);
+}
+
+double TerminalDistribution::volatilityAt(double strike) const {
+    return surface_ ? slice_.volatility(std::log(strike / forward_)) : volatility_;
+}
+
+double TerminalDistribution::expectedCall(double strike) const {
+    if (strike <= 0.0) {
+        return forward_ - strike;
+    }
+    double sigmaSqrtT = volatilityAt(strike) * sqrtT_;
+    double d1 = std::log(forward_ / strike) / sigmaSqrtT + 0.5 * sigmaSqrtT;
+    return forward_ * normalCdf(d1) - strike * normalCdf(d1 - sigmaSqrtT);
+}
+
+double TerminalDistribution::probabilityAbove(double strike) const {
+    if (strike <= 0.0) {
+        return 1.0;
+    }
+    if (std::isinf(strike)) {
+        return 0.0;
+    }
+    double sigma = volatilityAt(strike);
+    double sigmaSqrtT = sigma * sqrtT_;
+    double d1 = std::log(forward_ / strike) / sigmaSqrtT + 0.5 * sigmaSqrtT;
+    double probability = normalCdf(d1 - sigmaSqrtT);
+    if (surface_) {
+        // Smile slope by central difference in log-moneyness: dsigma/dK = dsigma/dk / K
+        const double h = 1e-4;
+        double k = std::log(strike / forward_);
+        double slope = (slice_.volatility(k + h) - slice_.volatility(k - h)) / (2.0 * h * strike);
+        probability -= forward_ * normalPdf(d1) * sqrtT_ * slope;
+    }
+    return std::min(std::max(probability, 0.0), 1.0);
+}
+
+double TerminalDistribution::probabilityBetween(double lower, double upper) const {
+    return std::max(probabilityAbove(lower) - probabilityAbove(upper), 0.0);
+}
@@ -0,0 +1,39 @@
+// TerminalDistribution.h
+#ifndef TERMINAL_DISTRIBUTION_H
+#define TERMINAL_DISTRIBUTION_H
+
+#include "VolatilitySurface.h"
+#include <memory>
+
+// Risk-neutral law of the underlying at one expiry, described through the two
+// quantities a piecewise-linear payoff needs: the undiscounted call value
+// E[max(S - K, 0)] and the tail probability P(S > K). Either lognormal with one
+// volatility, or implied by a volatility surface's smile at that expiry, in
+// which case the tail probability carries the smile's skew term
+//   P(S > K) = N(d2) - F phi(d1) sqrt(T) dsigma/dK.
+class TerminalDistribution {
+public:
+    TerminalDistribution(double forward, double volatility, double timeToMaturity);
+    TerminalDistribution(double forward, double timeToMaturity, std::shared_ptr<const VolatilitySurface> surface);
+    
+    double getForward() const { return forward_; }
+    double getTimeToMaturity() const { return timeToMaturity_; }
+    
+    double expectedCall(double strike) const;
+    double probabilityAbove(double strike) const;
+    
+    // P(lower < S <= upper); an upper bound of infinity covers the whole tail
+    double probabilityBetween(double lower, double upper) const;
+
+private:
+    double forward_;
+    double volatility_;
+    double timeToMaturity_;
+    double sqrtT_;
+    std::shared_ptr<const VolatilitySurface> surface_;
+    VolatilitySurface::Slice slice_;
+    
+    double volatilityAt(double strike) const;
+};
+
+#endif
@@ -0,0 +1,82 @@
+// ThreadPool.h
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Fixed-size pool of persistent worker threads. Tasks are queued FIFO and their
+// results are delivered through std::future.
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t numThreads = defaultThreadCount());
+    ~ThreadPool();
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    template <class F>
+    std::future<typename std::result_of<F()>::type> submit(F&& task) {
+        typedef typename std::result_of<F()>::type ResultType;
+        
+        // std::function needs a copyable callable, so the packaged_task lives on the heap
+        auto packaged = std::make_shared<std::packaged_task<ResultType()>>(std::forward<F>(task));
+        std::future<ResultType> result = packaged->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.emplace([packaged]() { (*packaged)(); });
+        }
+        condition_.notify_one();
+        return result;
+    }
+    
+    // Splits [0, count) into chunks of at most chunkSize and runs body(begin, end) for
+    // each on the pool, blocking until all chunks finish. Must not be called from a
+    // pool worker, since the caller waits on tasks queued behind it.
+    template <class F>
+    void parallelFor(size_t count, size_t chunkSize, F body) {
+        if (chunkSize == 0) {
+            chunkSize = 1;
+        }
+        
+        std::vector<std::future<void>> chunks;
+        for (size_t begin = 0; begin < count; begin += chunkSize) {
+            size_t end = std::min(count, begin + chunkSize);
+            chunks.push_back(submit([body, begin, end]() { body(begin, end); }));
+        }
+        // Wait for every chunk before rethrowing: body may reference the caller's frame
+        for (auto it = chunks.begin(); it != chunks.end(); ++it) {
+            it->wait();
+        }
+        for (auto it = chunks.begin(); it != chunks.end(); ++it) {
+            it->get();
+        }
+    }
+    
+    size_t size() const { return workers_.size(); }
+    
+    static size_t defaultThreadCount();
+    
+    // Process-wide pool of defaultThreadCount() workers, created on first use.
+    // Batch engines run on it by default so several of them working at once do
+    // not oversubscribe the machine; none may be called from one of its tasks.
+    static ThreadPool& shared();
+
+private:
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool stopping_;
+    
+    void workerLoop();
+};
+
+#endif
@@ -0,0 +1,187 @@
+#include "ValueAtRiskEngine.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+MarketScenarios MarketScenarios::historical(const std::vector<std::vector<double>>& spotHistory,
+                                            const std::vector<std::vector<double>>& volHistory) {
+    if (spotHistory.empty() || spotHistory.size() != volHistory.size()) {
+        throw std::invalid_argument("Need spot and vol histories for every underlying");
+    }
+    size_t days = spotHistory[0].size();
+    for (size_t u = 0; u < spotHistory.size(); ++u) {
+        if (spotHistory[u].size() != days || volHistory[u].size() != days) {
+            throw std::invalid_argument("All histories must cover the same days");
+        }
+    }
+    if (days < 2) {
+        throw std::invalid_argument("Need at least two observations to form a move");
+    }
+    
+    MarketScenarios scenarios;
+    scenarios.numScenarios = days - 1;
+    scenarios.numUnderlyings = spotHistory.size();
+    scenarios.spotReturns.resize(scenarios.numScenarios * scenarios.numUnderlyings);
+    scenarios.volChanges.resize(scenarios.numScenarios * scenarios.numUnderlyings);
+    for (size_t s = 0; s < scenarios.numScenarios; ++s) {
+        for (size_t u = 0; u < scenarios.numUnderlyings; ++u) {
+            size_t index = s * scenarios.numUnderlyings + u;
+            scenarios.spotReturns[index] = spotHistory[u][s + 1] / spotHistory[u][s] - 1.0;
+            scenarios.volChanges[index] = volHistory[u][s + 1] - volHistory[u][s];
+        }
+    }
+    return scenarios;
+}
+
+MarketScenarios MarketScenarios::simulated(size_t numScenarios, const std::vector<double>& spotVols,
+                                           const std::vector<double>& volOfVols, double crossCorrelation,
+                                           double spotVolCorrelation, double horizon, unsigned seed) {
+    if (spotVols.size() != volOfVols.size()) {
+        throw std::invalid_argument("Need a vol of vol for every underlying");
+    }
+    if (crossCorrelation < 0.0 || crossCorrelation > 1.0 || std::abs(spotVolCorrelation) > 1.0) {
+        throw std::invalid_argument("Correlations out of range");
+    }
+    
+    MarketScenarios scenarios;
+    scenarios.numScenarios = numScenarios;
+    scenarios.numUnderlyings = spotVols.size();
+    scenarios.spotReturns.resize(numScenarios * spotVols.size());
+    scenarios.volChanges.resize(numScenarios * spotVols.size());
+    
+    std::mt19937 generator(seed);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    double sqrtHorizon = std::sqrt(horizon);
+    double commonWeight = std::sqrt(crossCorrelation);
+    double idiosyncraticWeight = std::sqrt(1.0 - crossCorrelation);
+    double volWeight = std::sqrt(1.0 - spotVolCorrelation * spotVolCorrelation);
+    
+    for (size_t s = 0; s < numScenarios; ++s) {
+        double common = normal(generator);
+        for (size_t u = 0; u < spotVols.size(); ++u) {
+            double spotShock = commonWeight * common + idiosyncraticWeight * normal(generator);
+            double volShock = spotVolCorrelation * spotShock + volWeight * normal(generator);
+            
+            size_t index = s * spotVols.size() + u;
+            scenarios.spotReturns[index] = std::exp(spotVols[u] * sqrtHorizon * spotShock -
+                                                    0.5 * spotVols[u] * spotVols[u] * horizon) - 1.0;
+            scenarios.volChanges[index] = volOfVols[u] * sqrtHorizon * volShock;
+        }
+    }
+    return scenarios;
+}
+
+ValueAtRiskEngine::ValueAtRiskEngine(ThreadPool& pool) : pool_(pool) {}
+
+VaRResult ValueAtRiskEngine::compute(const OptionChain& book, const MarketScenarios& scenarios,
+                                     double confidence, RevaluationMode mode) {
+    if (!book.isFinalized()) {
+        throw std::logic_error("OptionChain must be finalized before VaR can be computed");
+    }
+    if (scenarios.numUnderlyings != book.getUnderlyings().size()) {
+        throw std::invalid_argument("Scenarios must cover every underlying of the book");
+    }
+    if (scenarios.numScenarios == 0) {
+        throw std::invalid_argument("Need at least one scenario");
+    }
+    if (confidence <= 0.0 || confidence >= 1.0) {
+        throw std::invalid_argument("Confidence must lie in (0, 1)");
+    }
+    for (auto it = scenarios.spotReturns.begin(); it != scenarios.spotReturns.end(); ++it) {
+        if (*it <= -1.0) {
+            throw std::invalid_argument("Spot moves must keep the spot positive");
+        }
+    }
+    
+    // Unshocked value and per-underlying Greeks
+    double baseValue = 0.0;
+    std::vector<Greeks> underlyingGreeks(book.getUnderlyings().size(), Greeks());
+    const std::vector<OptionChain::ExpiryGroup>& groups = book.getExpiryGroups();
+    for (size_t g = 0; g < groups.size(); ++g) {
+        blackScholesEngine_.accumulateGreeks(book, g, groups[g].begin, groups[g].end,
+                                             baseValue, underlyingGreeks[groups[g].underlying]);
+    }
+    
+    VaRResult result;
+    result.confidence = confidence;
+    result.pnl.assign(scenarios.numScenarios, 0.0);
+    if (mode == RevaluationMode::FULL) {
+        fullRevaluation(book, scenarios, baseValue, result.pnl);
+    } else {
+        deltaGammaVega(book, scenarios, underlyingGreeks, result.pnl);
+    }
+    
+    // Partition the losses around the quantile in O(n); the tail beyond it gives ES
+    std::vector<double> losses(result.pnl.size());
+    for (size_t s = 0; s < losses.size(); ++s) {
+        losses[s] = -result.pnl[s];
+    }
+    size_t tailCount = std::max<size_t>(1, static_cast<size_t>(std::floor((1.0 - confidence) * losses.size())));
+    size_t quantileIndex = losses.size() - tailCount;
+    std::nth_element(losses.begin(), losses.begin() + quantileIndex, losses.end());
+    
+    result.valueAtRisk = losses[quantileIndex];
+    double tailSum = 0.0;
+    for (size_t s = quantileIndex; s < losses.size(); ++s) {
+        tailSum += losses[s];
+    }
+    result.expectedShortfall = tailSum / tailCount;
+    return result;
+}
+
+void ValueAtRiskEngine::fullRevaluation(const OptionChain& book, const MarketScenarios& scenarios,
+                                        double baseValue, std::vector<double>& pnl) {
+    const std::vector<OptionChain::ExpiryGroup>& groups = book.getExpiryGroups();
+    const size_t numUnderlyings = scenarios.numUnderlyings;
+    size_t numBlocks = (scenarios.numScenarios + SCENARIO_BLOCK - 1) / SCENARIO_BLOCK;
+    
+    pool_.parallelFor(numBlocks, 1, [&](size_t firstBlock, size_t lastBlock) {
+        // One underlying's moves for the block, gathered contiguously
+        std::vector<double> spotShocks(SCENARIO_BLOCK);
+        std::vector<double> volShocks(SCENARIO_BLOCK);
+        
+        for (size_t block = firstBlock; block < lastBlock; ++block) {
+            size_t first = block * SCENARIO_BLOCK;
+            size_t count = std::min(SCENARIO_BLOCK, scenarios.numScenarios - first);
+            double* values = &pnl[first];
+            
+            size_t gatheredFor = numUnderlyings;
+            for (size_t g = 0; g < groups.size(); ++g) {
+                size_t u = groups[g].underlying;
+                if (u != gatheredFor) {
+                    for (size_t k = 0; k < count; ++k) {
+                        spotShocks[k] = scenarios.spotReturns[(first + k) * numUnderlyings + u];
+                        volShocks[k] = scenarios.volChanges[(first + k) * numUnderlyings + u];
+                    }
+                    gatheredFor = u;
+                }
+                blackScholesEngine_.accumulateJointShocks(book, g, groups[g].begin, groups[g].end,
+                                                          spotShocks.data(), volShocks.data(), count, values);
+            }
+            
+            for (size_t k = 0; k < count; ++k) {
+                values[k] -= baseValue;
+            }
+        }
+    });
+}
+
+void ValueAtRiskEngine::deltaGammaVega(const OptionChain& book, const MarketScenarios& scenarios,
+                                       const std::vector<Greeks>& underlyingGreeks, std::vector<double>& pnl) {
+    const std::vector<OptionChain::Underlying>& underlyings = book.getUnderlyings();
+    const size_t numUnderlyings = scenarios.numUnderlyings;
+    
+    // Greeks are reported with vega per vol point, so scale back to per unit of vol
+    for (size_t s = 0; s < scenarios.numScenarios; ++s) {
+        double total = 0.0;
+        for (size_t u = 0; u < numUnderlyings; ++u) {
+            size_t index = s * numUnderlyings + u;
+            double dS = underlyings[u].spot * scenarios.spotReturns[index];
+            double dVol = scenarios.volChanges[index];
+            const Greeks& greeks = underlyingGreeks[u];
+            total += greeks.delta * dS + 0.5 * greeks.gamma * dS * dS + greeks.vega * 100.0 * dVol;
+        }
+        pnl[s] = total;
+    }
+}
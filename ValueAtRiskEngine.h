@@ -0,0 +1,61 @@
+// ValueAtRiskEngine.h
+#ifndef VALUE_AT_RISK_ENGINE_H
+#define VALUE_AT_RISK_ENGINE_H
+
+#include "OptionChain.h"
+#include "BlackScholesEngine.h"
+#include "ThreadPool.h"
+#include <vector>
+
+// Joint one-period market moves, stored scenario-major: entry [s * numUnderlyings + u]
+// holds the relative spot move and absolute vol move of underlying u in scenario s.
+struct MarketScenarios {
+    size_t numScenarios, numUnderlyings;
+    std::vector<double> spotReturns;
+    std::vector<double> volChanges;
+    
+    // Consecutive-observation moves from level histories [underlying][day]
+    static MarketScenarios historical(const std::vector<std::vector<double>>& spotHistory,
+                                      const std::vector<std::vector<double>>& volHistory);
+    
+    // Lognormal spot and normal vol moves over the horizon. Spots share one common
+    // factor with the given correlation; each vol move correlates with its own spot.
+    static MarketScenarios simulated(size_t numScenarios, const std::vector<double>& spotVols,
+                                     const std::vector<double>& volOfVols, double crossCorrelation,
+                                     double spotVolCorrelation, double horizon = 1.0 / 252.0,
+                                     unsigned seed = 42);
+};
+
+enum class RevaluationMode { FULL, DELTA_GAMMA_VEGA };
+
+struct VaRResult {
+    double confidence;
+    double valueAtRisk;        // positive number = loss
+    double expectedShortfall;  // mean loss beyond the VaR quantile
+    std::vector<double> pnl;   // per scenario
+};
+
+// Portfolio VaR and ES over a MarketScenarios set. FULL mode reprices every leg
+// under every scenario with Black-Scholes; DELTA_GAMMA_VEGA uses per-underlying
+// Greeks of the unshocked book. Scenarios are processed in fixed-size blocks, one
+// pool task per block, so each pass over the book's columns serves a whole block.
+class ValueAtRiskEngine {
+public:
+    explicit ValueAtRiskEngine(ThreadPool& pool = ThreadPool::shared());
+    
+    VaRResult compute(const OptionChain& book, const MarketScenarios& scenarios,
+                      double confidence = 0.99, RevaluationMode mode = RevaluationMode::FULL);
+
+private:
+    BlackScholesEngine blackScholesEngine_;
+    ThreadPool& pool_;
+    
+    static const size_t SCENARIO_BLOCK = 64;
+    
+    void fullRevaluation(const OptionChain& book, const MarketScenarios& scenarios, double baseValue,
+                         std::vector<double>& pnl);
+    void deltaGammaVega(const OptionChain& book, const MarketScenarios& scenarios,
+                        const std::vector<Greeks>& underlyingGreeks, std::vector<double>& pnl);
+};
+
+#endif
@@ -0,0 +1,294 @@
+#include "VolatilitySurface.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+// Raw SVI with y = (k - m) / sigma is linear in (a, d, c) for fixed (m, sigma):
+// w = a + d * y + c * sqrt(y^2 + 1), where c = b * sigma and d = rho * b * sigma
+struct SmileData {
+    std::vector<double> k;
+    std::vector<double> w;
+};
+
+double sliceError(const SmileData& data, double m, double sigma, double a, double d, double c) {
+    double sse = 0.0;
+    for (size_t i = 0; i < data.k.size(); ++i) {
+        double y = (data.k[i] - m) / sigma;
+        double residual = a + d * y + c * std::sqrt(y * y + 1.0) - data.w[i];
+        sse += residual * residual;
+    }
+    return sse;
+}
+
+// Least squares on up to three basis functions via the normal equations
+bool solveNormalEquations(double A[3][3], double rhs[3], int n, double out[3]) {
+    for (int col = 0; col < n; ++col) {
+        int pivot = col;
+        for (int row = col + 1; row < n; ++row) {
+            if (std::abs(A[row][col]) > std::abs(A[pivot][col])) pivot = row;
+        }
+        if (std::abs(A[pivot][col]) < 1e-14) {
+            return false;
+        }
+        for (int j = 0; j < n; ++j) std::swap(A[col][j], A[pivot][j]);
+        std::swap(rhs[col], rhs[pivot]);
+        
+        for (int row = col + 1; row < n; ++row) {
+            double factor = A[row][col] / A[col][col];
+            for (int j = col; j < n; ++j) A[row][j] -= factor * A[col][j];
+            rhs[row] -= factor * rhs[col];
+        }
+    }
+    for (int row = n - 1; row >= 0; --row) {
+        double sum = rhs[row];
+        for (int j = row + 1; j < n; ++j) sum -= A[row][j] * out[j];
+        out[row] = sum / A[row][row];
+    }
+    return true;
+}
+
+// Best (a, d, c) for fixed (m, sigma) subject to c >= 0 and |d| <= c. The
+// unconstrained fit is tried first, then the d = +c, d = -c and flat edges.
+double fitLinear(const SmileData& data, double m, double sigma, double& a, double& d, double& c) {
+    double best = std::numeric_limits<double>::infinity();
+    
+    // direction 0: free (1, y, z); +1: (1, y + z); -1: (1, z - y)
+    for (int direction = 0; direction <= 2; ++direction) {
+        int n = (direction == 0) ? 3 : 2;
+        double A[3][3] = {}, rhs[3] = {}, x[3] = {};
+        for (size_t i = 0; i < data.k.size(); ++i) {
+            double y = (data.k[i] - m) / sigma;
+            double z = std::sqrt(y * y + 1.0);
+            double basis[3] = { 1.0, 0.0, 0.0 };
+            if (direction == 0) { basis[1] = y; basis[2] = z; }
+            else if (direction == 1) { basis[1] = y + z; }
+            else { basis[1] = z - y; }
+            for (int r = 0; r < n; ++r) {
+                for (int s = 0; s < n; ++s) A[r][s] += basis[r] * basis[s];
+                rhs[r] += basis[r] * data.w[i];
+            }
+        }
+        if (!solveNormalEquations(A, rhs, n, x)) {
+            continue;
+        }
+        
+        double ca, cd, cc;
+        if (direction == 0) { ca = x[0]; cd = x[1]; cc = x[2]; }
+        else if (direction == 1) { ca = x[0]; cd = x[1]; cc = x[1]; }
+        else { ca = x[0]; cd = -x[1]; cc = x[1]; }
+        if (cc < 0.0 || std::abs(cd) > cc * (1.0 + 1e-12)) {
+            continue;
+        }
+        
+        double sse = sliceError(data, m, sigma, ca, cd, cc);
+        if (sse < best) {
+            best = sse; a = ca; d = cd; c = cc;
+        }
+    }
+    
+    // Flat smile is always feasible
+    double mean = 0.0;
+    for (size_t i = 0; i < data.w.size(); ++i) mean += data.w[i];
+    mean /= data.w.size();
+    double flat = sliceError(data, m, sigma, mean, 0.0, 0.0);
+    if (flat < best) {
+        best = flat; a = mean; d = 0.0; c = 0.0;
+    }
+    
+    // Keep the minimum total variance a + sqrt(c^2 - d^2) non-negative
+    double floor = -std::sqrt(std::max(c * c - d * d, 0.0));
+    if (a < floor) {
+        a = floor;
+        best = sliceError(data, m, sigma, a, d, c);
+    }
+    return best;
+}
+
+double outerObjective(const SmileData& data, double m, double logSigma) {
+    double a, d, c;
+    return fitLinear(data, m, std::exp(logSigma), a, d, c);
+}
+
+}  // namespace
+
+VolatilitySurface::VolatilitySurface(const std::vector<double>& expiries, const std::vector<SviParameters>& parameters)
+    : expiries_(expiries), parameters_(parameters) {
+    if (expiries_.empty() || expiries_.size() != parameters_.size()) {
+        throw std::invalid_argument("Need one SVI parameter set per expiry");
+    }
+    for (size_t i = 0; i < expiries_.size(); ++i) {
+        if (expiries_[i] <= 0.0 || (i > 0 && expiries_[i] <= expiries_[i - 1])) {
+            throw std::invalid_argument("Surface expiries must be positive and strictly increasing");
+        }
+    }
+}
+
+VolatilitySurface VolatilitySurface::calibrate(const std::vector<ExpiryQuotes>& quotes, ThreadPool& pool) {
+    std::vector<ExpiryQuotes> sorted(quotes);
+    std::sort(sorted.begin(), sorted.end(), [](const ExpiryQuotes& x, const ExpiryQuotes& y) {
+        return x.timeToMaturity < y.timeToMaturity;
+    });
+    
+    std::vector<double> expiries(sorted.size());
+    std::vector<SviParameters> parameters(sorted.size());
+    std::vector<double> errors(sorted.size());
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        expiries[i] = sorted[i].timeToMaturity;
+    }
+    
+    pool.parallelFor(sorted.size(), 1, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            parameters[i] = fitSlice(sorted[i], errors[i]);
+        }
+    });
+    
+    VolatilitySurface surface(expiries, parameters);
+    surface.fitErrors_ = errors;
+    return surface;
+}
+
+VolatilitySurface::SviParameters VolatilitySurface::fitSlice(const ExpiryQuotes& quotes, double& rmse) {
+    if (quotes.strikes.size() != quotes.impliedVols.size() || quotes.strikes.size() < 5) {
+        throw std::invalid_argument("Each expiry needs at least five strike/vol quotes");
+    }
+    if (quotes.timeToMaturity <= 0.0 || quotes.forward <= 0.0) {
+        throw std::invalid_argument("Quotes need a positive expiry and forward");
+    }
+    
+    SmileData data;
+    for (size_t i = 0; i < quotes.strikes.size(); ++i) {
+        data.k.push_back(std::log(quotes.strikes[i] / quotes.forward));
+        data.w.push_back(quotes.impliedVols[i] * quotes.impliedVols[i] * quotes.timeToMaturity);
+    }
+    double kMin = *std::min_element(data.k.begin(), data.k.end());
+    double kMax = *std::max_element(data.k.begin(), data.k.end());
+    double kRange = std::max(kMax - kMin, 1e-3);
+    
+    // Coarse grid over (m, log sigma) to land in the right basin
+    double bestM = 0.0, bestLogSigma = std::log(0.1);
+    double bestValue = std::numeric_limits<double>::infinity();
+    for (int i = 0; i <= 10; ++i) {
+        double m = kMin + kRange * i / 10.0;
+        for (int j = 0; j <= 10; ++j) {
+            double logSigma = std::log(1e-3) + (std::log(2.0) - std::log(1e-3)) * j / 10.0;
+            double value = outerObjective(data, m, logSigma);
+            if (value < bestValue) {
+                bestValue = value; bestM = m; bestLogSigma = logSigma;
+            }
+        }
+    }
+    
+    // Nelder-Mead refinement in (m, log sigma)
+    double simplex[3][2] = { { bestM, bestLogSigma },
+                             { bestM + 0.1 * kRange, bestLogSigma },
+                             { bestM, bestLogSigma + 0.5 } };
+    double values[3];
+    for (int v = 0; v < 3; ++v) values[v] = outerObjective(data, simplex[v][0], simplex[v][1]);
+    
+    for (int iteration = 0; iteration < 400; ++iteration) {
+        // Order best, middle, worst
+        int order[3] = { 0, 1, 2 };
+        std::sort(order, order + 3, [&values](int x, int y) { return values[x] < values[y]; });
+        int best = order[0], middle = order[1], worst = order[2];
+        if (values[worst] - values[best] <= 1e-16 * (1.0 + values[best])) {
+            break;
+        }
+        
+        double centroid[2], reflected[2];
+        for (int j = 0; j < 2; ++j) {
+            centroid[j] = 0.5 * (simplex[best][j] + simplex[middle][j]);
+            reflected[j] = centroid[j] + (centroid[j] - simplex[worst][j]);
+        }
+        double reflectedValue = outerObjective(data, reflected[0], reflected[1]);
+        
+        if (reflectedValue < values[best]) {
+            double expanded[2];
+            for (int j = 0; j < 2; ++j) expanded[j] = centroid[j] + 2.0 * (centroid[j] - simplex[worst][j]);
+            double expandedValue = outerObjective(data, expanded[0], expanded[1]);
+            bool useExpanded = expandedValue < reflectedValue;
+            for (int j = 0; j < 2; ++j) simplex[worst][j] = useExpanded ? expanded[j] : reflected[j];
+            values[worst] = useExpanded ? expandedValue : reflectedValue;
+        } else if (reflectedValue < values[middle]) {
+            for (int j = 0; j < 2; ++j) simplex[worst][j] = reflected[j];
+            values[worst] = reflectedValue;
+        } else {
+            double contracted[2];
+            for (int j = 0; j < 2; ++j) contracted[j] = centroid[j] + 0.5 * (simplex[worst][j] - centroid[j]);
+            double contractedValue = outerObjective(data, contracted[0], contracted[1]);
+            if (contractedValue < values[worst]) {
+                for (int j = 0; j < 2; ++j) simplex[worst][j] = contracted[j];
+                values[worst] = contractedValue;
+            } else {
+                // Shrink towards the best vertex
+                for (int v = 0; v < 3; ++v) {
+                    if (v == best) continue;
+                    for (int j = 0; j < 2; ++j) simplex[v][j] = simplex[best][j] + 0.5 * (simplex[v][j] - simplex[best][j]);
+                    values[v] = outerObjective(data, simplex[v][0], simplex[v][1]);
+                }
+            }
+        }
+    }
+    
+    int best = static_cast<int>(std::min_element(values, values + 3) - values);
+    double m = simplex[best][0];
+    double sigma = std::exp(simplex[best][1]);
+    double a, d, c;
+    fitLinear(data, m, sigma, a, d, c);
+    
+    SviParameters parameters;
+    parameters.a = a;
+    parameters.b = c / sigma;
+    parameters.rho = (c > 0.0) ? d / c : 0.0;
+    parameters.m = m;
+    parameters.sigma = sigma;
+    
+    double squaredError = 0.0;
+    for (size_t i = 0; i < data.k.size(); ++i) {
+        double fitted = std::sqrt(std::max(parameters.totalVariance(data.k[i]), 0.0) / quotes.timeToMaturity);
+        squaredError += (fitted - quotes.impliedVols[i]) * (fitted - quotes.impliedVols[i]);
+    }
+    rmse = std::sqrt(squaredError / data.k.size());
+    return parameters;
+}
+
+VolatilitySurface::Slice VolatilitySurface::sliceAt(double timeToMaturity) const {
+    if (timeToMaturity <= 0.0) {
+        throw std::invalid_argument("Time to maturity must be positive");
+    }
+    
+    Slice slice;
+    slice.timeToMaturity_ = timeToMaturity;
+    size_t upper = std::upper_bound(expiries_.begin(), expiries_.end(), timeToMaturity) - expiries_.begin();
+    if (upper == 0 || upper == expiries_.size()) {
+        // Outside the quoted range: hold the nearest smile's volatility flat
+        size_t nearest = (upper == 0) ? 0 : expiries_.size() - 1;
+        slice.lower_ = slice.upper_ = &parameters_[nearest];
+        slice.lowerWeight_ = timeToMaturity / expiries_[nearest];
+        slice.upperWeight_ = 0.0;
+        return slice;
+    }
+    
+    size_t lower = upper - 1;
+    double span = expiries_[upper] - expiries_[lower];
+    slice.lower_ = &parameters_[lower];
+    slice.upper_ = &parameters_[upper];
+    slice.upperWeight_ = (timeToMaturity - expiries_[lower]) / span;
+    slice.lowerWeight_ = 1.0 - slice.upperWeight_;
+    return slice;
+}
+
+double VolatilitySurface::volatility(const Option& option) const {
+    double T = option.getTimeToMaturity();
+    double logMoneyness = std::log(option.getStrike() / option.getSpot()) -
+                          (option.getRate() - option.getDividendYield()) * T;
+    return volatility(logMoneyness, T);
+}
+
+Option VolatilitySurface::applyTo(const Option& option) const {
+    return Option(option.getSpot(), option.getStrike(), option.getRate(), volatility(option),
+                  option.getTimeToMaturity(), option.getOptionType(), option.getExerciseType(),
+                  option.getDividendYield());
+}
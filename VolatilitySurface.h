@@ -0,0 +1,82 @@
+// VolatilitySurface.h
+#ifndef VOLATILITY_SURFACE_H
+#define VOLATILITY_SURFACE_H
+
+#include "Option.h"
+#include "ThreadPool.h"
+#include <vector>
+
+// Implied volatility keyed by log-forward-moneyness k = ln(K / F) and expiry. Each
+// quoted expiry carries a raw-SVI total-variance smile; between expiries total
+// variance is interpolated linearly in time at fixed k, and beyond the quoted
+// range the nearest smile's volatility is held flat. Calendar-spread arbitrage
+// between independently fitted slices is not checked.
+class VolatilitySurface {
+public:
+    // w(k) = a + b * (rho * (k - m) + sqrt((k - m)^2 + sigma^2))
+    struct SviParameters {
+        double a, b, rho, m, sigma;
+        
+        double totalVariance(double k) const {
+            double x = k - m;
+            return a + b * (rho * x + std::sqrt(x * x + sigma * sigma));
+        }
+    };
+    
+    struct ExpiryQuotes {
+        double timeToMaturity;
+        double forward;
+        std::vector<double> strikes;
+        std::vector<double> impliedVols;
+    };
+    
+    // The surface at one maturity: the bracketing smiles and their time weights.
+    // Resolve once per expiry, then each strike lookup is O(1).
+    class Slice {
+    public:
+        double totalVariance(double k) const {
+            return lowerWeight_ * lower_->totalVariance(k) + upperWeight_ * upper_->totalVariance(k);
+        }
+        double volatility(double k) const {
+            return std::sqrt(std::max(totalVariance(k), 0.0) / timeToMaturity_);
+        }
+    
+    private:
+        friend class VolatilitySurface;
+        const SviParameters* lower_;
+        const SviParameters* upper_;
+        double lowerWeight_, upperWeight_;
+        double timeToMaturity_;
+    };
+    
+    VolatilitySurface(const std::vector<double>& expiries, const std::vector<SviParameters>& parameters);
+    
+    // Fits one raw-SVI smile per expiry to the quoted implied vols, expiries in parallel
+    static VolatilitySurface calibrate(const std::vector<ExpiryQuotes>& quotes,
+                                       ThreadPool& pool = ThreadPool::shared());
+    
+    Slice sliceAt(double timeToMaturity) const;
+    double volatility(double logMoneyness, double timeToMaturity) const {
+        return sliceAt(timeToMaturity).volatility(logMoneyness);
+    }
+    
+    // Vol for the option's own strike and maturity, with moneyness taken against
+    // its forward S * exp((r - q)T) (sticky moneyness)
+    double volatility(const Option& option) const;
+    Option applyTo(const Option& option) const;
+    
+    const std::vector<double>& getExpiries() const { return expiries_; }
+    const std::vector<SviParameters>& getParameters() const { return parameters_; }
+    
+    // Root-mean-square implied-vol error of each fitted slice; empty unless calibrated
+    const std::vector<double>& getFitErrors() const { return fitErrors_; }
+
+private:
+    std::vector<double> expiries_;
+    std::vector<SviParameters> parameters_;
+    std::vector<double> fitErrors_;
+    
+    static SviParameters fitSlice(const ExpiryQuotes& quotes, double& rmse);
+};
+
+#endif
@@ -1,4 +1,7 @@
 #include "WebServer.h"
+#include "PayoffProfile.h"
+#include "StrategyEngine.h"
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <thread>
@@ -8,10 +11,35 @@
 #include <cstring>
 #include <cmath>
 #include <iomanip>
+#include <stdexcept>
 
 WebServer::WebServer(int port) : port_(port), running_(false) {
-    engine_.setBinomialSteps(1000);
-    engine_.setMonteCarloSimulations(100000);
+    engine_.setBinomialSteps(DEFAULT_BINOMIAL_STEPS);
+    engine_.setMonteCarloSimulations(DEFAULT_MONTE_CARLO_SIMULATIONS);
+    engine_.setMethodDeadline(std::chrono::seconds(10));
+}
+
+void WebServer::loadAmericanPriceTables(const std::string& directory) {
+    std::shared_ptr<const AmericanPriceTable> tables[2];
+    const char* names[2] = {"american_call.table", "american_put.table"};
+    for (int i = 0; i < 2; ++i) {
+        std::string path = directory + "/" + names[i];
+        try {
+            tables[i] = std::make_shared<const AmericanPriceTable>(AmericanPriceTable::load(path));
+            std::cout << "Loaded American price table " << path << " (validation error "
+                      << tables[i]->getValidationError() << " per unit strike)" << std::endl;
+        } catch (const std::exception& e) {
+            std::cout << e.what() << "; using the binomial tree" << std::endl;
+        }
+    }
+    if (!tables[0] && !tables[1]) {
+        return;
+    }
+    
+    engine_.setAmericanPriceTables(tables[0], tables[1]);
+    PricingConfig config = engine_.getDefaultConfig();
+    config.useAmericanPriceTables = true;
+    engine_.setDefaultConfig(config);
 }
 
 void WebServer::start() {
@@ -92,6 +120,14 @@ void WebServer::handleClient(int client_socket) {
             auto params = parseQueryString(query);
             std::string result = generateStrategyData(params);
             sendHTTPResponse(client_socket, result, "application/json");
+        } else if (request.find("GET /market-update?") != std::string::npos) {
+            size_t query_start = request.find("?") + 1;
+            size_t query_end = request.find(" ", query_start);
+            std::string query = request.substr(query_start, query_end - query_start);
+            
+            auto params = parseQueryString(query);
+            std::string result = handleMarketUpdate(params);
+            sendHTTPResponse(client_socket, result, "application/json");
         } else {
             sendHTTPResponse(client_socket, "<h1>404 Not Found</h1>");
         }
@@ -608,6 +644,21 @@ std::string WebServer::generateHTML() {
     html += "    tension: 0\n";
     html += "  });\n";
     html += "  \n";
+    html += "  (data.horizonCurves || []).forEach(curve => {\n";
+    html += "    const atInputVol = Math.abs(curve.volatility - currentOptionData.volatility) < 1e-9;\n";
+    html += "    payoffChart.data.datasets.push({\n";
+    html += "      label: `T+${curve.days}d @ ${(curve.volatility * 100).toFixed(1)}% vol`,\n";
+    html += "      data: curve.pnl,\n";
+    html += "      borderColor: atInputVol ? (curve.days === 0 ? '#007bff' : '#17a2b8') : '#adb5bd',\n";
+    html += "      backgroundColor: 'transparent',\n";
+    html += "      borderWidth: atInputVol ? 2 : 1,\n";
+    html += "      borderDash: curve.days === 0 ? [] : [6, 4],\n";
+    html += "      pointRadius: 0,\n";
+    html += "      fill: false,\n";
+    html += "      tension: 0\n";
+    html += "    });\n";
+    html += "  });\n";
+    html += "  \n";
     html += "  if (data.breakevens && data.breakevens.length > 0) {\n";
     html += "    const breakevenPoints = data.breakevens.map(be => ({ x: be, y: 0 }));\n";
     html += "    payoffChart.data.datasets.push({\n";
@@ -736,6 +787,14 @@ std::string WebServer::generateHTML() {
     html += "            <span class=\"analysis-value\">${typeof data.maxProfit === 'string' ? data.maxProfit : '$' + data.maxProfit.toFixed(2)}</span>\n";
     html += "          </div>\n";
     html += "          <div class=\"analysis-item\">\n";
+    html += "            <span>Probability of Profit:</span>\n";
+    html += "            <span class=\"analysis-value\">${data.probProfit.toFixed(1)}%</span>\n";
+    html += "          </div>\n";
+    html += "          <div class=\"analysis-item\">\n";
+    html += "            <span>Expected P&L:</span>\n";
+    html += "            <span class=\"analysis-value\">$${data.expectedPnL.toFixed(2)}</span>\n";
+    html += "          </div>\n";
+    html += "          <div class=\"analysis-item\">\n";
     html += "            <span>Strategy Type:</span>\n";
     html += "            <span class=\"analysis-value\">${strategyPosition === 'long' ? 'Debit' : 'Credit'}</span>\n";
     html += "          </div>\n";
@@ -868,6 +927,108 @@ std::string WebServer::generateHTML() {
     return html;
 }
 
+namespace {
+
+// Profile metrics are infinite when unbounded, which the page shows as text
+void writeMetric(std::ostringstream& json, const char* name, double value) {
+    json << ",\"" << name << "\":";
+    if (std::isinf(value)) {
+        json << "\"Unlimited\"";
+    } else {
+        json << value;
+    }
+}
+
+void writeArray(std::ostringstream& json, const char* name, const std::vector<double>& values) {
+    json << "\"" << name << "\":[";
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (i > 0) json << ",";
+        json << values[i];
+    }
+    json << "]";
+}
+
+std::vector<double> priceGrid(double minPrice, double maxPrice, int numPoints) {
+    std::vector<double> prices(numPoints + 1);
+    double priceStep = (maxPrice - minPrice) / numPoints;
+    for (int i = 0; i <= numPoints; ++i) {
+        prices[i] = minPrice + i * priceStep;
+    }
+    return prices;
+}
+
+// Text for a JSON string literal: quotes, backslashes and control characters escaped
+std::string jsonEscape(const std::string& text) {
+    std::ostringstream escaped;
+    for (size_t i = 0; i < text.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c == '"' || c == '\\') {
+            escaped << '\\' << text[i];
+        } else if (c < 0x20) {
+            escaped << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+        } else {
+            escaped << text[i];
+        }
+    }
+    return escaped.str();
+}
+
+// Whole positive integers up to maximum; "1e10" or "100.5" would otherwise parse as a prefix
+int parseCount(const std::string& text, const std::string& name, int maximum) {
+    size_t parsed = 0;
+    long long value = 0;
+    try {
+        value = std::stoll(text, &parsed);
+    } catch (const std::exception&) {
+        parsed = 0;
+    }
+    if (parsed == 0 || parsed != text.size() || value < 1 || value > maximum) {
+        throw std::invalid_argument(name + " must be an integer between 1 and " + std::to_string(maximum));
+    }
+    return static_cast<int>(value);
+}
+
+void writeHorizonCurves(std::ostringstream& json, const std::vector<HorizonCurve>& curves) {
+    json << "\"horizonCurves\":[";
+    for (size_t i = 0; i < curves.size(); ++i) {
+        if (i > 0) json << ",";
+        json << "{\"days\":" << std::lround(curves[i].horizon * 365.0) << ",\"volatility\":" << curves[i].volatility << ",";
+        writeArray(json, "pnl", curves[i].pnl);
+        json << "}";
+    }
+    json << "]";
+}
+
+// A named strategy's leg relative to the form's strikes: strike + offset, or
+// strike2 when usesStrike2 and the request provides one
+struct LegTemplate {
+    OptionType type;
+    double quantity;
+    double offset;
+    bool usesStrike2;
+};
+
+struct StrategyTemplate {
+    std::vector<LegTemplate> legs;
+    double stockQuantity;  // stock-plus-option strategies are quoted from the stockholder's side only
+};
+
+const std::map<std::string, StrategyTemplate>& strategyTemplates() {
+    static const std::map<std::string, StrategyTemplate> templates = {
+        {"straddle", {{{OptionType::CALL, 1, 0, false}, {OptionType::PUT, 1, 0, false}}, 0}},
+        {"strangle", {{{OptionType::CALL, 1, 5, true}, {OptionType::PUT, 1, 0, false}}, 0}},
+        {"bullspread", {{{OptionType::CALL, 1, 0, false}, {OptionType::CALL, -1, 10, true}}, 0}},
+        {"bearspread", {{{OptionType::PUT, 1, 10, true}, {OptionType::PUT, -1, 0, false}}, 0}},
+        {"ironcondor", {{{OptionType::PUT, -1, -10, false}, {OptionType::PUT, 1, -5, false},
+                         {OptionType::CALL, 1, 5, false}, {OptionType::CALL, -1, 10, true}}, 0}},
+        {"coveredcall", {{{OptionType::CALL, -1, 0, false}}, 1}},
+        {"protectiveput", {{{OptionType::PUT, 1, 0, false}}, 1}},
+    };
+    return templates;
+}
+
+}
+
 std::string WebServer::generateStrategyData(const std::map<std::string, std::string>& params) {
     try {
         double spot = std::stod(params.at("spot"));
@@ -875,271 +1036,70 @@ std::string WebServer::generateStrategyData(const std::map<std::string, std::str
         double rate = std::stod(params.at("rate"));
         double volatility = std::stod(params.at("volatility"));
         double timeToMaturity = std::stod(params.at("timeToMaturity"));
-        int optionType = std::stoi(params.at("optionType"));
         int exerciseType = std::stoi(params.at("exerciseType"));
         std::string strategy = params.at("strategy");
         std::string strategyPosition = params.count("strategyPosition") ? params.at("strategyPosition") : "long";
         
-        OptionType optType = (optionType == 0) ? OptionType::CALL : OptionType::PUT;
         ExerciseType exType = (exerciseType == 0) ? ExerciseType::EUROPEAN : ExerciseType::AMERICAN;
         
-        Option option(spot, strike, rate, volatility, timeToMaturity, optType, exType);
-        auto prices = engine_.priceAllMethods(option);
-        double premium = prices["BlackScholes"];
-        
-        double minPrice = strike * 0.5;
-        double maxPrice = strike * 1.5;
-        int numPoints = 100;
-        double priceStep = (maxPrice - minPrice) / numPoints;
-        
-        std::ostringstream json;
-        json << std::fixed << std::setprecision(4);
-        json << "{";
+        auto found = strategyTemplates().find(strategy);
+        if (found == strategyTemplates().end()) {
+            throw std::invalid_argument("Unknown strategy: " + strategy);
+        }
+        const StrategyTemplate& definition = found->second;
         
-        json << "\"prices\":[";
-        for (int i = 0; i <= numPoints; ++i) {
-            double price = minPrice + i * priceStep;
-            if (i > 0) json << ",";
-            json << price;
+        // The short side flips every option leg
+        double sign = (strategyPosition == "short" && definition.stockQuantity == 0.0) ? -1.0 : 1.0;
+        StrategySpec spec;
+        spec.stockQuantity = definition.stockQuantity;
+        spec.stockEntryPrice = spot;
+        for (const auto& leg : definition.legs) {
+            double legStrike = (leg.usesStrike2 && params.count("strike2")) ? std::stod(params.at("strike2"))
+                                                                            : strike + leg.offset;
+            StrategyLeg strategyLeg = { leg.type, legStrike, timeToMaturity, sign * leg.quantity, exType };
+            spec.legs.push_back(strategyLeg);
         }
-        json << "],";
         
-        json << "\"strategyPnL\":[";
+        StrategyMarket market = { spot, rate, volatility };
+        std::vector<double> prices = priceGrid(strike * 0.5, strike * 1.5, 100);
+        StrategyEngine strategyEngine(engine_);
+        StrategyAnalysis analysis = strategyEngine.analyze(spec, market, prices);
         
-        if (strategy == "straddle") {
-            Option callOption(spot, strike, rate, volatility, timeToMaturity, OptionType::CALL, exType);
-            Option putOption(spot, strike, rate, volatility, timeToMaturity, OptionType::PUT, exType);
-            auto callPrices = engine_.priceAllMethods(callOption);
-            auto putPrices = engine_.priceAllMethods(putOption);
-            double callPremium = callPrices["BlackScholes"];
-            double putPremium = putPrices["BlackScholes"];
-            double totalPremium = callPremium + putPremium;
-            
-            for (int i = 0; i <= numPoints; ++i) {
-                double price = minPrice + i * priceStep;
-                double callPayoff = std::max(price - strike, 0.0);
-                double putPayoff = std::max(strike - price, 0.0);
-                double strategyPnL;
-                
-                if (strategyPosition == "short") {
-                    strategyPnL = totalPremium - callPayoff - putPayoff;
-                } else {
-                    strategyPnL = callPayoff + putPayoff - totalPremium;
-                }
-                
-                if (i > 0) json << ",";
-                json << strategyPnL;
-            }
-            
-            json << "],\"netPremium\":" << (strategyPosition == "long" ? -totalPremium : totalPremium);
-            if (strategyPosition == "long") {
-                json << ",\"maxRisk\":" << totalPremium;
-                json << ",\"maxProfit\":\"Unlimited\"";
-            } else {
-                json << ",\"maxRisk\":\"Unlimited\"";
-                json << ",\"maxProfit\":" << totalPremium;
-            }
-            json << ",\"breakevens\":[" << (strike - totalPremium) << "," << (strike + totalPremium) << "]";
-            
-        } else if (strategy == "strangle") {
-            double callStrike = params.count("strike2") ? std::stod(params.at("strike2")) : strike + 5;
-            double putStrike = strike;
-            
-            Option callOption(spot, callStrike, rate, volatility, timeToMaturity, OptionType::CALL, exType);
-            Option putOption(spot, putStrike, rate, volatility, timeToMaturity, OptionType::PUT, exType);
-            auto callPrices = engine_.priceAllMethods(callOption);
-            auto putPrices = engine_.priceAllMethods(putOption);
-            double callPremium = callPrices["BlackScholes"];
-            double putPremium = putPrices["BlackScholes"];
-            double totalPremium = callPremium + putPremium;
-            
-            for (int i = 0; i <= numPoints; ++i) {
-                double price = minPrice + i * priceStep;
-                double callPayoff = std::max(price - callStrike, 0.0);
-                double putPayoff = std::max(putStrike - price, 0.0);
-                double strategyPnL;
-                
-                if (strategyPosition == "short") {
-                    strategyPnL = totalPremium - callPayoff - putPayoff;
-                } else {
-                    strategyPnL = callPayoff + putPayoff - totalPremium;
-                }
-                
-                if (i > 0) json << ",";
-                json << strategyPnL;
-            }
-            
-            json << "],\"netPremium\":" << (strategyPosition == "long" ? -totalPremium : totalPremium);
-            if (strategyPosition == "long") {
-                json << ",\"maxRisk\":" << totalPremium;
-                json << ",\"maxProfit\":\"Unlimited\"";
-            } else {
-                json << ",\"maxRisk\":\"Unlimited\"";
-                json << ",\"maxProfit\":" << totalPremium;
-            }
-            json << ",\"breakevens\":[" << (putStrike - totalPremium) << "," << (callStrike + totalPremium) << "]";
-            
-        } else if (strategy == "bullspread") {
-            double longStrike = strike;
-            double shortStrike = params.count("strike2") ? std::stod(params.at("strike2")) : strike + 10;
-            
-            Option longCall(spot, longStrike, rate, volatility, timeToMaturity, OptionType::CALL, exType);
-            Option shortCall(spot, shortStrike, rate, volatility, timeToMaturity, OptionType::CALL, exType);
-            auto longPrices = engine_.priceAllMethods(longCall);
-            auto shortPrices = engine_.priceAllMethods(shortCall);
-            double longPremium = longPrices["BlackScholes"];
-            double shortPremium = shortPrices["BlackScholes"];
-            double netPremium = longPremium - shortPremium;
-            
-            for (int i = 0; i <= numPoints; ++i) {
-                double price = minPrice + i * priceStep;
-                double longCallPnL = std::max(price - longStrike, 0.0) - longPremium;
-                double shortCallPnL = shortPremium - std::max(price - shortStrike, 0.0);
-                double strategyPnL = longCallPnL + shortCallPnL;
-                
-                if (strategyPosition == "short") {
-                    strategyPnL = -strategyPnL;
-                }
-                
-                if (i > 0) json << ",";
-                json << strategyPnL;
-            }
-            
-            json << "],\"netPremium\":" << (strategyPosition == "long" ? -netPremium : netPremium);
-            if (strategyPosition == "long") {
-                json << ",\"maxRisk\":" << netPremium;
-                json << ",\"maxProfit\":" << (shortStrike - longStrike - netPremium);
-            } else {
-                json << ",\"maxRisk\":" << (shortStrike - longStrike - netPremium);
-                json << ",\"maxProfit\":" << netPremium;
-            }
-            json << ",\"breakevens\":[" << (longStrike + netPremium) << "]";
-            
-        } else if (strategy == "bearspread") {
-            double longStrike = params.count("strike2") ? std::stod(params.at("strike2")) : strike + 10;
-            double shortStrike = strike;
-            
-            Option longPut(spot, longStrike, rate, volatility, timeToMaturity, OptionType::PUT, exType);
-            Option shortPut(spot, shortStrike, rate, volatility, timeToMaturity, OptionType::PUT, exType);
-            auto longPrices = engine_.priceAllMethods(longPut);
-            auto shortPrices = engine_.priceAllMethods(shortPut);
-            double longPremium = longPrices["BlackScholes"];
-            double shortPremium = shortPrices["BlackScholes"];
-            double netPremium = longPremium - shortPremium;
-            
-            for (int i = 0; i <= numPoints; ++i) {
-                double price = minPrice + i * priceStep;
-                double longPutPnL = std::max(longStrike - price, 0.0) - longPremium;
-                double shortPutPnL = shortPremium - std::max(shortStrike - price, 0.0);
-                double strategyPnL = longPutPnL + shortPutPnL;
-                
-                if (strategyPosition == "short") {
-                    strategyPnL = -strategyPnL;
-                }
-                
-                if (i > 0) json << ",";
-                json << strategyPnL;
-            }
-            
-            json << "],\"netPremium\":" << (strategyPosition == "long" ? -netPremium : netPremium);
-            if (strategyPosition == "long") {
-                json << ",\"maxRisk\":" << netPremium;
-                json << ",\"maxProfit\":" << (longStrike - shortStrike - netPremium);
-            } else {
-                json << ",\"maxRisk\":" << (longStrike - shortStrike - netPremium);
-                json << ",\"maxProfit\":" << netPremium;
-            }
-            json << ",\"breakevens\":[" << (longStrike - netPremium) << "]";
-            
-        } else if (strategy == "ironcondor") {
-            double putStrike1 = strike - 10;
-            double putStrike2 = strike - 5;
-            double callStrike1 = strike + 5;
-            double callStrike2 = params.count("strike2") ? std::stod(params.at("strike2")) : strike + 10;
-            
-            Option shortPut1(spot, putStrike1, rate, volatility, timeToMaturity, OptionType::PUT, exType);
-            Option longPut2(spot, putStrike2, rate, volatility, timeToMaturity, OptionType::PUT, exType);
-            Option longCall1(spot, callStrike1, rate, volatility, timeToMaturity, OptionType::CALL, exType);
-            Option shortCall2(spot, callStrike2, rate, volatility, timeToMaturity, OptionType::CALL, exType);
-            
-            auto putPrices1 = engine_.priceAllMethods(shortPut1);
-            auto putPrices2 = engine_.priceAllMethods(longPut2);
-            auto callPrices1 = engine_.priceAllMethods(longCall1);
-            auto callPrices2 = engine_.priceAllMethods(shortCall2);
-            
-            double netCredit = putPrices1["BlackScholes"] - putPrices2["BlackScholes"] + 
-                              callPrices2["BlackScholes"] - callPrices1["BlackScholes"];
-            
-            for (int i = 0; i <= numPoints; ++i) {
-                double price = minPrice + i * priceStep;
-                
-                double putSpreadPnL = putPrices1["BlackScholes"] - std::max(putStrike1 - price, 0.0) -
-                                     putPrices2["BlackScholes"] + std::max(putStrike2 - price, 0.0);
-                double callSpreadPnL = callPrices2["BlackScholes"] - std::max(price - callStrike2, 0.0) -
-                                      callPrices1["BlackScholes"] + std::max(price - callStrike1, 0.0);
-                
-                double strategyPnL = putSpreadPnL + callSpreadPnL;
-                
-                if (strategyPosition == "short") {
-                    strategyPnL = -strategyPnL;
-                }
-                
-                if (i > 0) json << ",";
-                json << strategyPnL;
-            }
-            
-            json << "],\"netPremium\":" << (strategyPosition == "long" ? -netCredit : netCredit);
-            if (strategyPosition == "long") {
-                json << ",\"maxRisk\":" << (putStrike2 - putStrike1 - netCredit);
-                json << ",\"maxProfit\":" << netCredit;
-            } else {
-                json << ",\"maxRisk\":\"Unlimited\"";
-                json << ",\"maxProfit\":\"Unlimited\"";
-            }
-            json << ",\"breakevens\":[" << (putStrike2 - netCredit) << "," << (callStrike1 + netCredit) << "]";
-            
-        } else if (strategy == "coveredcall") {
-            double callPremium = premium;
-            
-            for (int i = 0; i <= numPoints; ++i) {
-                double price = minPrice + i * priceStep;
-                double stockPnL = price - spot;
-                double callPnL = callPremium - std::max(price - strike, 0.0);
-                double strategyPnL = stockPnL + callPnL;
-                
-                if (i > 0) json << ",";
-                json << strategyPnL;
-            }
-            
-            json << "],\"netPremium\":" << callPremium;
-            json << ",\"maxRisk\":\"Stock decline\"";
-            json << ",\"maxProfit\":" << (strike - spot + callPremium);
-            json << ",\"breakevens\":[" << (spot - callPremium) << "]";
-            
-        } else if (strategy == "protectiveput") {
-            double putPremium = premium;
-            
-            for (int i = 0; i <= numPoints; ++i) {
-                double price = minPrice + i * priceStep;
-                double stockPnL = price - spot;
-                double putPnL = std::max(strike - price, 0.0) - putPremium;
-                double strategyPnL = stockPnL + putPnL;
-                
-                if (i > 0) json << ",";
-                json << strategyPnL;
-            }
-            
-            json << "],\"netPremium\":" << -putPremium;
-            json << ",\"maxRisk\":" << (spot - strike + putPremium);
-            json << ",\"maxProfit\":\"Unlimited\"";
-            json << ",\"breakevens\":[" << (spot + putPremium) << "]";
-        }
+        // Today and halfway to expiry, at the input vol and 25% either side of it
+        std::vector<double> horizons = { 0.0, 0.5 * timeToMaturity };
+        std::vector<double> vols = { 0.75 * volatility, volatility, 1.25 * volatility };
+        std::vector<HorizonCurve> curves = strategyEngine.horizonCurves(spec, market, analysis.premiums, prices,
+                                                                        horizons, vols);
         
-        json << ",\"probProfit\":65.5";
+        // Distribution of expiry P&L over the range the chart shows
+        auto range = std::minmax_element(analysis.pnl.begin(), analysis.pnl.end());
+        std::vector<double> levels = priceGrid(*range.first, *range.second, 40);
+        StrategyOutcome outcome = strategyEngine.outcome(spec, market, analysis.premiums, levels);
+        
+        std::ostringstream json;
+        json << std::fixed << std::setprecision(4);
+        json << "{";
+        writeArray(json, "prices", prices);
+        json << ",";
+        writeArray(json, "strategyPnL", analysis.pnl);
+        json << ",\"netPremium\":" << analysis.netPremium;
+        writeMetric(json, "maxRisk", analysis.maxLoss);
+        writeMetric(json, "maxProfit", analysis.maxProfit);
+        json << ",";
+        writeArray(json, "breakevens", analysis.breakevens);
+        json << ",";
+        writeHorizonCurves(json, curves);
+        json << ",\"probProfit\":" << 100.0 * outcome.probabilityOfProfit;
+        json << ",\"expectedPnL\":" << outcome.expectedPnL;
+        json << ",\"pnlDistribution\":{";
+        writeArray(json, "levels", levels);
+        json << ",";
+        writeArray(json, "cumulative", outcome.cumulative);
+        json << "}";
         json << "}";
         
         return json.str();
-        
+    
     } catch (const std::exception& e) {
         return "{\"error\":\"" + std::string(e.what()) + "\"}";
     }
@@ -1159,127 +1119,62 @@ std::string WebServer::generatePayoffData(const std::map<std::string, std::strin
         ExerciseType exType = (exerciseType == 0) ? ExerciseType::EUROPEAN : ExerciseType::AMERICAN;
         
         Option option(spot, strike, rate, volatility, timeToMaturity, optType, exType);
-        auto prices = engine_.priceAllMethods(option);
-        double premium = prices["BlackScholes"];
-        
-        double minPrice = strike * 0.5;
-        double maxPrice = strike * 1.5;
-        int numPoints = 100;
-        double priceStep = (maxPrice - minPrice) / numPoints;
+        double premium = blackScholesPremium(option);
         
-        std::ostringstream json;
-        json << std::fixed << std::setprecision(4);
-        json << "{";
+        OptionStrategy longLeg, shortLeg;
+        longLeg.addLeg(option, PositionType::LONG, premium);
+        shortLeg.addLeg(option, PositionType::SHORT, premium);
+        PayoffProfile longProfile(longLeg);
+        PayoffProfile shortProfile(shortLeg);
         
-        json << "\"prices\":[";
-        for (int i = 0; i <= numPoints; ++i) {
-            double price = minPrice + i * priceStep;
-            if (i > 0) json << ",";
-            json << price;
+        std::vector<double> prices = priceGrid(strike * 0.5, strike * 1.5, 100);
+        std::vector<double> pnlLong = longProfile.evaluate(prices);
+        std::vector<double> pnlShort = shortProfile.evaluate(prices);
+        std::vector<double> payoffs(pnlLong.size());
+        for (size_t i = 0; i < payoffs.size(); ++i) {
+            payoffs[i] = pnlLong[i] + premium;
         }
-        json << "],";
         
-        json << "\"payoffs\":[";
-        for (int i = 0; i <= numPoints; ++i) {
-            double price = minPrice + i * priceStep;
-            double payoff = 0;
-            
-            if (optionType == 0) {
-                payoff = std::max(price - strike, 0.0);
-            } else {
-                payoff = std::max(strike - price, 0.0);
-            }
-            
-            if (i > 0) json << ",";
-            json << payoff;
-        }
-        json << "],";
-        
-        json << "\"pnl_long\":[";
-        for (int i = 0; i <= numPoints; ++i) {
-            double price = minPrice + i * priceStep;
-            double payoff = 0;
-            
-            if (optionType == 0) {
-                payoff = std::max(price - strike, 0.0);
-            } else {
-                payoff = std::max(strike - price, 0.0);
-            }
-            
-            double pnl = payoff - premium;
-            
-            if (i > 0) json << ",";
-            json << pnl;
-        }
-        json << "],";
-        
-        json << "\"pnl_short\":[";
-        for (int i = 0; i <= numPoints; ++i) {
-            double price = minPrice + i * priceStep;
-            double payoff = 0;
-            
-            if (optionType == 0) {
-                payoff = std::max(price - strike, 0.0);
-            } else {
-                payoff = std::max(strike - price, 0.0);
-            }
-            
-            double pnl = premium - payoff;
-            
-            if (i > 0) json << ",";
-            json << pnl;
-        }
-        json << "],";
-        
-        double breakeven_long = 0;
-        double breakeven_short = 0;
-        
-        if (optionType == 0) {
-            breakeven_long = strike + premium;
-            breakeven_short = strike + premium;
-        } else {
-            breakeven_long = strike - premium;
-            breakeven_short = strike - premium;
-        }
-        
-        json << "\"breakeven_long\":" << breakeven_long << ",";
-        json << "\"breakeven_short\":" << breakeven_short << ",";
-        json << "\"maxRisk_long\":" << premium << ",";
-        json << "\"maxRisk_short\":\"Unlimited\",";
-        json << "\"premium\":" << premium << ",";
-        
-        if (optionType == 0) {
-            json << "\"maxProfit_long\":\"Unlimited\",";
-            json << "\"maxProfit_short\":" << premium;
-        } else {
-            double maxProfit_long = std::max(0.0, strike - premium);
-            json << "\"maxProfit_long\":" << maxProfit_long << ",";
-            json << "\"maxProfit_short\":" << premium;
-        }
+        // A single leg crosses zero exactly once, at strike +/- premium
+        std::vector<double> breakevens = longProfile.breakevens();
+        double breakeven = breakevens.empty() ? 0.0 : breakevens.front();
         
+        std::ostringstream json;
+        json << std::fixed << std::setprecision(4);
+        json << "{";
+        writeArray(json, "prices", prices);
+        json << ",";
+        writeArray(json, "payoffs", payoffs);
+        json << ",";
+        writeArray(json, "pnl_long", pnlLong);
+        json << ",";
+        writeArray(json, "pnl_short", pnlShort);
+        json << ",\"breakeven_long\":" << breakeven;
+        json << ",\"breakeven_short\":" << breakeven;
+        writeMetric(json, "maxRisk_long", longProfile.maxLoss());
+        writeMetric(json, "maxRisk_short", shortProfile.maxLoss());
+        json << ",\"premium\":" << premium;
+        writeMetric(json, "maxProfit_long", longProfile.maxProfit());
+        writeMetric(json, "maxProfit_short", shortProfile.maxProfit());
         json << "}";
         return json.str();
-        
+    
     } catch (const std::exception& e) {
         return "{\"error\":\"" + std::string(e.what()) + "\"}";
     }
 }
 
+double WebServer::blackScholesPremium(const Option& option) {
+    // Chart routes only display the Black-Scholes premium, so skip the tree and Monte Carlo runs
+    return engine_.priceMethods(option, std::vector<std::string>(1, "BlackScholes"))["BlackScholes"];
+}
+
 std::string WebServer::handlePricingRequest(const std::map<std::string, std::string>& params) {
     try {
-        double spot = std::stod(params.at("spot"));
-        double strike = std::stod(params.at("strike"));
-        double rate = std::stod(params.at("rate"));
-        double volatility = std::stod(params.at("volatility"));
-        double timeToMaturity = std::stod(params.at("timeToMaturity"));
-        int optionType = std::stoi(params.at("optionType"));
-        int exerciseType = std::stoi(params.at("exerciseType"));
-        
-        OptionType optType = (optionType == 0) ? OptionType::CALL : OptionType::PUT;
-        ExerciseType exType = (exerciseType == 0) ? ExerciseType::EUROPEAN : ExerciseType::AMERICAN;
-        
-        Option option(spot, strike, rate, volatility, timeToMaturity, optType, exType);
-        auto prices = engine_.priceAllMethods(option);
+        Option option = parseOption(params);
+        PricingConfig config = parsePricingConfig(params);
+        std::vector<std::string> timedOut;
+        auto prices = engine_.priceAllMethods(option, config, engine_.getMethodDeadline(), &timedOut);
         
         std::ostringstream json;
         json << std::fixed << std::setprecision(6);
@@ -1293,7 +1188,16 @@ std::string WebServer::handlePricingRequest(const std::map<std::string, std::str
         }
         json << "}";
         
-        if (exerciseType == 0) {
+        if (!timedOut.empty()) {
+            json << ",\"timedOut\":[";
+            for (size_t i = 0; i < timedOut.size(); ++i) {
+                if (i > 0) json << ",";
+                json << "\"" << timedOut[i] << "\"";
+            }
+            json << "]";
+        }
+        
+        if (option.getExerciseType() == ExerciseType::EUROPEAN) {
             auto greeks = engine_.calculateGreeks(option);
             json << ",\"greeks\":{";
             first = true;
@@ -1307,12 +1211,71 @@ std::string WebServer::handlePricingRequest(const std::map<std::string, std::str
         
         json << "}";
         return json.str();
-        
+    
     } catch (const std::exception& e) {
         return "{\"error\":\"" + std::string(e.what()) + "\"}";
     }
 }
 
+Option WebServer::parseOption(const std::map<std::string, std::string>& params) {
+    double strike = std::stod(params.at("strike"));
+    double timeToMaturity = std::stod(params.at("timeToMaturity"));
+    OptionType optType = (std::stoi(params.at("optionType")) == 0) ? OptionType::CALL : OptionType::PUT;
+    ExerciseType exType = (std::stoi(params.at("exerciseType")) == 0) ? ExerciseType::EUROPEAN : ExerciseType::AMERICAN;
+    
+    // With a symbol, spot, rate and volatility come from the latest published market snapshot
+    auto symbol = params.find("symbol");
+    if (symbol == params.end()) {
+        return Option(std::stod(params.at("spot")), strike, std::stod(params.at("rate")),
+                      std::stod(params.at("volatility")), timeToMaturity, optType, exType);
+    }
+    
+    MarketDataStore::ReadGuard snapshot(marketData_);
+    size_t instrument = snapshot->find(symbol->second);
+    if (instrument == MarketSnapshot::npos) {
+        throw std::invalid_argument("Unknown symbol: " + symbol->second);
+    }
+    OptionContract contract = { instrument, strike, timeToMaturity, optType, exType };
+    return snapshot->makeOption(contract);
+}
+
+std::string WebServer::handleMarketUpdate(const std::map<std::string, std::string>& params) {
+    try {
+        const std::string& symbol = params.at("symbol");
+        MarketQuote quote;
+        quote.spot = std::stod(params.at("spot"));
+        quote.rate = std::stod(params.at("rate"));
+        quote.volatility = std::stod(params.at("volatility"));
+        
+        uint64_t version = marketData_.set(symbol, quote);
+        
+        std::ostringstream json;
+        json << "{\"symbol\":\"" << jsonEscape(symbol) << "\",\"version\":" << version << "}";
+        return json.str();
+    
+    } catch (const std::exception& e) {
+        return "{\"error\":\"" + jsonEscape(e.what()) + "\"}";
+    }
+}
+
+PricingConfig WebServer::parsePricingConfig(const std::map<std::string, std::string>& params) {
+    // Optional per-request accuracy overrides on top of the server defaults
+    PricingConfig config = engine_.getDefaultConfig();
+    if (params.count("steps")) {
+        // An explicit step count asks for that tree, not the price tables
+        config.binomialSteps = parseCount(params.at("steps"), "steps", MAX_BINOMIAL_STEPS);
+        config.useAmericanPriceTables = false;
+    }
+    if (params.count("simulations")) {
+        config.monteCarloSimulations = parseCount(params.at("simulations"), "simulations",
+                                                  MAX_MONTE_CARLO_SIMULATIONS);
+    }
+    if (params.count("seed")) {
+        config.seed = static_cast<unsigned int>(std::stoul(params.at("seed")));
+    }
+    return config;
+}
+
 std::map<std::string, std::string> WebServer::parseQueryString(const std::string& query) {
     std::map<std::string, std::string> params;
     std::istringstream iss(query);
@@ -2,24 +2,42 @@
 #define WEB_SERVER_H
 
 #include "OptionsPricingEngine.h"
+#include "MarketDataStore.h"
 #include <string>
 #include <map>
 
 class WebServer {
 private:
     OptionsPricingEngine engine_;
+    MarketDataStore marketData_;
     int port_;
     bool running_;
     
+    // Per-request accuracy overrides above these are rejected: ten times the
+    // server defaults, so one request cannot hold a pool worker for long
+    static const int DEFAULT_BINOMIAL_STEPS = 1000;
+    static const int DEFAULT_MONTE_CARLO_SIMULATIONS = 100000;
+    static const int MAX_BINOMIAL_STEPS = 10 * DEFAULT_BINOMIAL_STEPS;
+    static const int MAX_MONTE_CARLO_SIMULATIONS = 10 * DEFAULT_MONTE_CARLO_SIMULATIONS;
+    
     std::string generateHTML();
     std::string handlePricingRequest(const std::map<std::string, std::string>& params);
     std::string generatePayoffData(const std::map<std::string, std::string>& params);
     std::string generateStrategyData(const std::map<std::string, std::string>& params);
+    std::string handleMarketUpdate(const std::map<std::string, std::string>& params);
+    double blackScholesPremium(const Option& option);
     std::map<std::string, std::string> parseQueryString(const std::string& query);
+    Option parseOption(const std::map<std::string, std::string>& params);
+    PricingConfig parsePricingConfig(const std::map<std::string, std::string>& params);
     void sendHTTPResponse(int client_socket, const std::string& content, const std::string& contentType = "text/html");
-    
+
 public:
     WebServer(int port = 8081);
+    
+    // Loads american_call.table and american_put.table from directory and prices
+    // in-domain American options from them by default. A missing or unreadable
+    // file leaves that option type on the binomial tree.
+    void loadAmericanPriceTables(const std::string& directory);
     void start();
     void stop();
     void handleClient(int client_socket);
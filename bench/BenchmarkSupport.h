@@ -0,0 +1,58 @@
+// BenchmarkSupport.h
+#ifndef BENCHMARK_SUPPORT_H
+#define BENCHMARK_SUPPORT_H
+
+#include "OptionChain.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+// Random European book: underlyings spread between 50 and 150, expiries evenly
+// from 3M to 2.5Y, strikes within 30% of spot, vols 15-45%, signed quantities
+inline OptionChain syntheticBook(size_t numLegs, size_t numUnderlyings, size_t expiriesPerUnderlying,
+                                 unsigned seed = 7) {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    
+    OptionChain book;
+    std::vector<double> spots(numUnderlyings);
+    for (size_t u = 0; u < numUnderlyings; ++u) {
+        spots[u] = 50.0 + 100.0 * uniform(generator);
+        book.addUnderlying("U" + std::to_string(u), spots[u], 0.03);
+    }
+    for (size_t leg = 0; leg < numLegs; ++leg) {
+        size_t u = leg % numUnderlyings;
+        size_t expiry = (leg / numUnderlyings) % expiriesPerUnderlying;
+        double timeToMaturity = expiriesPerUnderlying > 1
+            ? 0.25 + 2.25 * expiry / (expiriesPerUnderlying - 1) : 1.0;
+        double strike = spots[u] * (0.7 + 0.6 * uniform(generator));
+        double volatility = 0.15 + 0.3 * uniform(generator);
+        OptionType type = uniform(generator) < 0.5 ? OptionType::CALL : OptionType::PUT;
+        double quantity = (uniform(generator) < 0.5 ? -1.0 : 1.0) * (1 + static_cast<int>(10 * uniform(generator)));
+        book.addOption(u, strike, timeToMaturity, volatility, type, ExerciseType::EUROPEAN, quantity);
+    }
+    book.finalize();
+    return book;
+}
+
+// Best wall time of runs calls, in milliseconds
+template <class F>
+double bestOfMilliseconds(F call, int runs) {
+    double best = 0.0;
+    for (int run = 0; run < runs; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        call();
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        best = (run == 0) ? elapsed : std::min(best, elapsed);
+    }
+    return best;
+}
+
+// Optional positional size argument, for shrinking a run on slow machines
+inline size_t sizeArgument(int argc, char** argv, int index, size_t fallback) {
+    return argc > index ? static_cast<size_t>(std::strtoull(argv[index], nullptr, 10)) : fallback;
+}
+
+#endif
@@ -0,0 +1,35 @@
+// delta_hedge_bench.cpp
+// DeltaHedgeEngine throughput in paths x rebalances per second, with the hedging
+// error's standard deviation against its discrete-hedging approximation.
+// Usage: delta_hedge_bench [paths=100000] [rebalances=252]
+#include "BenchmarkSupport.h"
+#include "DeltaHedgeEngine.h"
+#include <cmath>
+#include <cstdio>
+
+int main(int argc, char** argv) {
+    size_t numPaths = sizeArgument(argc, argv, 1, 100000);
+    size_t rebalances = sizeArgument(argc, argv, 2, 252);
+    
+    Option call(100.0, 100.0, 0.03, 0.2, 0.25, OptionType::CALL, ExerciseType::EUROPEAN, 0.01);
+    DeltaHedgeSettings settings;
+    settings.numPaths = numPaths;
+    settings.rebalances = rebalances;
+    DeltaHedgeEngine engine;
+    
+    HedgeErrorDistribution distribution;
+    double engineMs = bestOfMilliseconds([&]() { distribution = engine.simulate(call, settings); }, 3);
+    
+    double pathRebalances = static_cast<double>(numPaths) * rebalances;
+    std::printf("%zu paths x %zu rebalances, %zu threads\n", numPaths, rebalances, ThreadPool::shared().size());
+    std::printf("DeltaHedgeEngine::simulate %9.1f ms  (%.3g path-rebalances/s)\n", engineMs,
+                pathRebalances / (engineMs * 1e-3));
+    
+    // Sanity check on the error distribution; vega() is per vol point
+    BlackScholesEngine blackScholes;
+    double theory = std::sqrt(M_PI / 4.0) * 100.0 * blackScholes.vega(call) * call.getVolatility() /
+                    std::sqrt(static_cast<double>(rebalances));
+    std::printf("hedging error mean %.4f, sd %.4f (sqrt(pi/4) vega sigma / sqrt(N) = %.4f)\n", distribution.mean,
+                distribution.standardDeviation, theory);
+    return 0;
+}
@@ -0,0 +1,62 @@
+// scenario_bench.cpp
+// Spot x vol scenario ladder over a 100k-leg book, against pricing every
+// shocked leg through OptionsPricingEngine.
+// Usage: scenario_bench [legs=100000] [underlyings=10] [expiries=20]
+#include "BenchmarkSupport.h"
+#include "OptionsPricingEngine.h"
+#include "ScenarioEngine.h"
+#include <cmath>
+#include <cstdio>
+
+int main(int argc, char** argv) {
+    size_t numLegs = sizeArgument(argc, argv, 1, 100000);
+    size_t numUnderlyings = sizeArgument(argc, argv, 2, 10);
+    size_t numExpiries = sizeArgument(argc, argv, 3, 20);
+    
+    OptionChain book = syntheticBook(numLegs, numUnderlyings, numExpiries);
+    ScenarioGrid grid = ScenarioGrid::symmetric();
+    ScenarioEngine engine;
+    OptionsPricingEngine pricer;
+    
+    ScenarioCube cube;
+    double engineMs = bestOfMilliseconds([&]() { cube = engine.run(book, grid); }, 3);
+    
+    // Total P&L per cell from one price() call per shocked leg
+    const size_t numCells = grid.spotShocks.size() * grid.volShocks.size();
+    std::vector<double> naive(numCells);
+    double naiveMs = bestOfMilliseconds([&]() {
+        std::fill(naive.begin(), naive.end(), 0.0);
+        const double* quantities = book.quantities();
+        for (size_t leg = 0; leg < book.size(); ++leg) {
+            Option option = book.toOption(leg);
+            double base = pricer.price(option, PricingMethod::BLACK_SCHOLES);
+            for (size_t s = 0; s < grid.spotShocks.size(); ++s) {
+                for (size_t v = 0; v < grid.volShocks.size(); ++v) {
+                    Option shocked(option.getSpot() * (1.0 + grid.spotShocks[s]), option.getStrike(),
+                                   option.getRate(), option.getVolatility() + grid.volShocks[v],
+                                   option.getTimeToMaturity(), option.getOptionType(), option.getExerciseType(),
+                                   option.getDividendYield());
+                    naive[s * grid.volShocks.size() + v] +=
+                        quantities[leg] * (pricer.price(shocked, PricingMethod::BLACK_SCHOLES) - base);
+                }
+            }
+        }
+    }, 1);
+    
+    double maxDifference = 0.0;
+    for (size_t s = 0; s < grid.spotShocks.size(); ++s) {
+        for (size_t v = 0; v < grid.volShocks.size(); ++v) {
+            maxDifference = std::max(maxDifference,
+                                     std::abs(cube.total(s, v) - naive[s * grid.volShocks.size() + v]));
+        }
+    }
+    
+    std::printf("%zu legs, %zu underlyings, %zu x %zu grid, %zu threads\n", book.size(), numUnderlyings,
+                grid.spotShocks.size(), grid.volShocks.size(), ThreadPool::shared().size());
+    std::printf("ScenarioEngine::run          %9.1f ms  (%.1f ns/leg-cell)\n", engineMs,
+                engineMs * 1e6 / (numLegs * numCells));
+    std::printf("nested price() calls         %9.1f ms  (%.1f ns/leg-cell)\n", naiveMs,
+                naiveMs * 1e6 / (numLegs * numCells));
+    std::printf("max |total P&L difference|   %9.2e\n", maxDifference);
+    return 0;
+}
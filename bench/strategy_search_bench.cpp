@@ -0,0 +1,145 @@
+// strategy_search_bench.cpp
+// StrategySearchEngine over a 200-strike chain for each objective, with and
+// without credit/max-loss constraints, plus a brute-force cross-check of the
+// top scores on a smaller chain.
+// Usage: strategy_search_bench [strikes=200] [checkStrikes=30]
+#include "BenchmarkSupport.h"
+#include "PayoffProfile.h"
+#include "StrategySearchEngine.h"
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+namespace {
+
+const char* objectiveName(StrategyObjective objective) {
+    switch (objective) {
+        case StrategyObjective::EXPECTED_VALUE: return "expected value";
+        case StrategyObjective::PROBABILITY_OF_PROFIT: return "probability of profit";
+        default: return "return on risk";
+    }
+}
+
+// Every vertical and iron condor scored through PayoffProfile, best first
+std::vector<double> bruteForceScores(OptionsPricingEngine& pricer, const StrategyMarket& market,
+                                     double timeToMaturity, const std::vector<double>& strikes,
+                                     const StrategySearchSettings& settings) {
+    StrategyEngine strategies(pricer);
+    double forward = market.spot * std::exp((market.rate - market.dividendYield) * timeToMaturity);
+    TerminalDistribution law(forward, settings.viewVolatility, timeToMaturity);
+    std::vector<double> scores;
+    
+    auto score = [&](const StrategySpec& spec) {
+        std::vector<double> premiums = strategies.premiums(spec, market);
+        PayoffProfile profile = StrategyEngine::profile(spec, premiums);
+        double credit = 0.0;
+        for (size_t leg = 0; leg < premiums.size(); ++leg) {
+            credit -= spec.legs[leg].quantity * premiums[leg];
+        }
+        if (profile.maxLoss() > settings.maxLoss || credit < settings.minCredit) {
+            return;
+        }
+        double expectedValue = profile.expectedValue(law);
+        switch (settings.objective) {
+            case StrategyObjective::EXPECTED_VALUE: scores.push_back(expectedValue); break;
+            case StrategyObjective::PROBABILITY_OF_PROFIT: scores.push_back(profile.probabilityOfProfit(law)); break;
+            default: scores.push_back(expectedValue / profile.maxLoss()); break;
+        }
+    };
+    
+    const size_t n = strikes.size();
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = i + 1; j < n; ++j) {
+            // Bull call, bear put, bull put and bear call spreads on (K_i, K_j)
+            for (int family = 0; family < 4; ++family) {
+                OptionType type = (family == 0 || family == 3) ? OptionType::CALL : OptionType::PUT;
+                double lower = (family == 0 || family == 2) ? 1.0 : -1.0;
+                StrategySpec spec;
+                spec.legs = { { type, strikes[i], timeToMaturity, lower, ExerciseType::EUROPEAN },
+                              { type, strikes[j], timeToMaturity, -lower, ExerciseType::EUROPEAN } };
+                score(spec);
+            }
+            for (size_t k = j; k < n; ++k) {
+                for (size_t l = k + 1; l < n; ++l) {
+                    StrategySpec spec;
+                    spec.legs = { { OptionType::PUT, strikes[i], timeToMaturity, 1.0, ExerciseType::EUROPEAN },
+                                  { OptionType::PUT, strikes[j], timeToMaturity, -1.0, ExerciseType::EUROPEAN },
+                                  { OptionType::CALL, strikes[k], timeToMaturity, -1.0, ExerciseType::EUROPEAN },
+                                  { OptionType::CALL, strikes[l], timeToMaturity, 1.0, ExerciseType::EUROPEAN } };
+                    score(spec);
+                }
+            }
+        }
+    }
+    std::sort(scores.begin(), scores.end(), [](double a, double b) { return a > b; });
+    return scores;
+}
+
+}
+
+int main(int argc, char** argv) {
+    size_t numStrikes = sizeArgument(argc, argv, 1, 200);
+    size_t numCheckStrikes = sizeArgument(argc, argv, 2, 30);
+    
+    OptionsPricingEngine pricer;
+    StrategySearchEngine search(pricer);
+    StrategyMarket market = { 100.0, 0.03, 0.25, 0.0 };
+    const double timeToMaturity = 0.25;
+    const StrategyObjective objectives[] = { StrategyObjective::EXPECTED_VALUE,
+                                             StrategyObjective::PROBABILITY_OF_PROFIT,
+                                             StrategyObjective::RETURN_ON_RISK };
+    
+    std::vector<double> strikes(numStrikes);
+    for (size_t i = 0; i < numStrikes; ++i) {
+        strikes[i] = 50.0 + 0.5 * i;
+    }
+    std::printf("%zu strikes, S = 100, view vol 20%% against 25%% implied, top 10, %zu threads\n", numStrikes,
+                ThreadPool::shared().size());
+    for (StrategyObjective objective : objectives) {
+        for (int constrained = 0; constrained < 2; ++constrained) {
+            StrategySearchSettings settings;
+            settings.objective = objective;
+            settings.viewVolatility = 0.2;
+            if (constrained) {
+                settings.maxLoss = 5.0;
+                settings.minCredit = 0.25;
+            }
+            StrategySearchStats stats;
+            std::vector<StrategyCandidate> top;
+            double elapsedMs = bestOfMilliseconds([&]() {
+                top = search.search(market, timeToMaturity, strikes, settings, &stats);
+            }, 3);
+            std::printf("%-22s %-26s %9.1f ms  enumerated %12llu  scored %12llu  best %.5f\n",
+                        objectiveName(objective), constrained ? "max loss 5, credit 0.25" : "unconstrained",
+                        elapsedMs, static_cast<unsigned long long>(stats.enumerated),
+                        static_cast<unsigned long long>(stats.evaluated), top.empty() ? 0.0 : top[0].score);
+        }
+    }
+    
+    // Cross-check the top scores against scoring every combination directly
+    std::vector<double> checkStrikes(numCheckStrikes);
+    for (size_t i = 0; i < numCheckStrikes; ++i) {
+        checkStrikes[i] = 80.0 + 1.5 * i;
+    }
+    bool matched = true;
+    for (StrategyObjective objective : objectives) {
+        StrategySearchSettings settings;
+        settings.objective = objective;
+        settings.topK = 5;
+        settings.maxLoss = 8.0;
+        settings.minCredit = 0.5;
+        settings.viewVolatility = 0.2;
+        std::vector<StrategyCandidate> top = search.search(market, timeToMaturity, checkStrikes, settings);
+        std::vector<double> expected = bruteForceScores(pricer, market, timeToMaturity, checkStrikes, settings);
+        
+        double maxDifference = top.size() == std::min(expected.size(), settings.topK)
+            ? 0.0 : std::numeric_limits<double>::infinity();
+        for (size_t i = 0; i < top.size() && i < expected.size(); ++i) {
+            maxDifference = std::max(maxDifference, std::abs(top[i].score - expected[i]));
+        }
+        matched = matched && maxDifference < 1e-9;
+        std::printf("brute force, %zu strikes, %-22s max |top-5 score difference| %.2e\n", numCheckStrikes,
+                    objectiveName(objective), maxDifference);
+    }
+    return matched ? 0 : 1;
+}
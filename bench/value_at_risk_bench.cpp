@@ -0,0 +1,33 @@
+// value_at_risk_bench.cpp
+// Full and delta-gamma-vega VaR over simulated one-day scenarios.
+// Usage: value_at_risk_bench [scenarios=10000] [legs=100000] [underlyings=10]
+#include "BenchmarkSupport.h"
+#include "ValueAtRiskEngine.h"
+#include <cstdio>
+
+int main(int argc, char** argv) {
+    size_t numScenarios = sizeArgument(argc, argv, 1, 10000);
+    size_t numLegs = sizeArgument(argc, argv, 2, 100000);
+    size_t numUnderlyings = sizeArgument(argc, argv, 3, 10);
+    
+    OptionChain book = syntheticBook(numLegs, numUnderlyings, 20);
+    MarketScenarios scenarios = MarketScenarios::simulated(numScenarios, std::vector<double>(numUnderlyings, 0.25),
+                                                           std::vector<double>(numUnderlyings, 0.8), 0.5, -0.6);
+    ValueAtRiskEngine engine;
+    
+    VaRResult full, approximate;
+    double fullMs = bestOfMilliseconds([&]() { full = engine.compute(book, scenarios, 0.99, RevaluationMode::FULL); }, 1);
+    double approximateMs = bestOfMilliseconds([&]() {
+        approximate = engine.compute(book, scenarios, 0.99, RevaluationMode::DELTA_GAMMA_VEGA);
+    }, 5);
+    
+    double positionScenarios = static_cast<double>(numLegs) * numScenarios;
+    std::printf("%zu scenarios x %zu positions, %zu underlyings, %zu threads\n", numScenarios, numLegs,
+                numUnderlyings, ThreadPool::shared().size());
+    std::printf("full revaluation     %10.1f ms  (%.1f ns/position-scenario, %.2f s per 10k x 100k)\n", fullMs,
+                fullMs * 1e6 / positionScenarios, fullMs * 1e9 / positionScenarios * 1e-3);
+    std::printf("delta-gamma-vega     %10.1f ms\n", approximateMs);
+    std::printf("99%% VaR %.4f / ES %.4f (full), %.4f / %.4f (delta-gamma-vega)\n", full.valueAtRisk,
+                full.expectedShortfall, approximate.valueAtRisk, approximate.expectedShortfall);
+    return 0;
+}
@@ -0,0 +1,107 @@
+// allocation_test.cpp
+// Counts heap allocations made by the enum-dispatched pricing API once warm.
+#include "OptionsPricingEngine.h"
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<long> allocations(0);
+
+}
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+int main() {
+    const int REPETITIONS = 200;
+    
+    OptionsPricingEngine engine;
+    engine.setMonteCarloSimulations(2000);
+    
+    Option european(100.0, 105.0, 0.05, 0.2, 0.5, OptionType::CALL, ExerciseType::EUROPEAN);
+    Option american(100.0, 95.0, 0.05, 0.25, 1.0, OptionType::PUT, ExerciseType::AMERICAN, 0.01);
+    const Option* options[] = { &european, &american };
+    
+    MethodPrices prices;
+    Greeks greeks;
+    double checksum = 0.0;  // keeps the calls observable; unsupported methods report NaN
+    auto accumulate = [&checksum](double value) {
+        if (std::isfinite(value)) {
+            checksum += value;
+        }
+    };
+    
+    // Warm-up sizes thread-local scratch buffers
+    for (const Option* option : options) {
+        for (int method = 0; method < MethodPrices::NUM_METHODS; ++method) {
+            accumulate(engine.price(*option, static_cast<PricingMethod>(method)));
+        }
+        engine.priceAllMethods(*option, prices);
+        engine.calculateGreeks(*option, greeks);
+    }
+    
+    int failures = 0;
+    for (const Option* option : options) {
+        const char* label = option == &european ? "European" : "American";
+        
+        long before = allocations.load();
+        for (int i = 0; i < REPETITIONS; ++i) {
+            for (int method = 0; method < MethodPrices::NUM_METHODS; ++method) {
+                accumulate(engine.price(*option, static_cast<PricingMethod>(method)));
+            }
+        }
+        long priceAllocations = allocations.load() - before;
+        
+        before = allocations.load();
+        for (int i = 0; i < REPETITIONS; ++i) {
+            engine.priceAllMethods(*option, prices);
+            accumulate(prices[PricingMethod::BINOMIAL]);
+        }
+        long allMethodsAllocations = allocations.load() - before;
+        
+        before = allocations.load();
+        for (int i = 0; i < REPETITIONS; ++i) {
+            engine.calculateGreeks(*option, greeks);
+            accumulate(greeks.delta);
+        }
+        long greeksAllocations = allocations.load() - before;
+        
+        std::printf("%s: price %ld, priceAllMethods %ld, calculateGreeks %ld allocations\n",
+                    label, priceAllocations, allMethodsAllocations, greeksAllocations);
+        if (priceAllocations != 0 || allMethodsAllocations != 0 || greeksAllocations != 0) {
+            ++failures;
+        }
+    }
+    
+    std::printf("%s (checksum %.6f)\n", failures == 0 ? "PASSED" : "FAILED", checksum);
+    return failures == 0 ? 0 : 1;
+}
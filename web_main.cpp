@@ -1,4 +1,5 @@
 #include "WebServer.h"
+#include <cstdlib>
 #include <iostream>
 #include <signal.h>
 
@@ -17,6 +18,10 @@ int main() {
     
     server = new WebServer(8081);  // Port 8081
     
+    // Precomputed American price tables, if present: AMERICAN_PRICE_TABLES or ./tables
+    const char* tableDirectory = std::getenv("AMERICAN_PRICE_TABLES");
+    server->loadAmericanPriceTables(tableDirectory ? tableDirectory : "tables");
+    
     std::cout << "Starting Options Pricing Engine Web Server..." << std::endl;
     std::cout << "Open your browser and go to: http://localhost:8081" << std::endl;  // Changed to 8081
     std::cout << "Press Ctrl+C to stop the server" << std::endl;